@@ -0,0 +1,66 @@
+#pragma once
+#include "vector.h"
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+// Размер строки кэша, на который по умолчанию выравниваются буферы AlignedAllocator
+inline constexpr size_t kCacheLineSize = 64;
+
+// Аллокатор, выравнивающий каждый блок по границе Alignment байт при помощи выровненного operator new.
+// Размер блока округляется вверх до кратного Alignment, поэтому блоки разных векторов не делят
+// строки кэша и не подвержены ложному разделению. Alignment должен быть степенью двойки не меньше alignof(T)
+template <typename T, size_t Alignment = kCacheLineSize>
+class AlignedAllocator {
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(T), "Alignment must not be less than alignof(T)");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    static constexpr size_t kAlignment = Alignment;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(GetBytes(n), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        ::operator delete(p, GetBytes(n), std::align_val_t{Alignment});
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>& /*other*/) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>& /*other*/) const noexcept {
+        return false;
+    }
+
+private:
+    static size_t GetBytes(size_t n) {
+        if (n > (std::numeric_limits<size_t>::max() - Alignment) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return (n * sizeof(T) + Alignment - 1) & ~(Alignment - 1);
+    }
+};
+
+// Вектор, буфер которого выровнен по Alignment байт, например для выровненных загрузок SIMD
+template <typename T, size_t Alignment = kCacheLineSize, typename GrowthPolicy = DoublingGrowth<>>
+using AlignedVector = Vector<T, AlignedAllocator<T, Alignment>, GrowthPolicy>;
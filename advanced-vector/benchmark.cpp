@@ -0,0 +1,451 @@
+#include "vector.h"
+#include "concurrent_vector.h"
+#include "cow_vector.h"
+#include "flat_map.h"
+#include "ring_vector.h"
+#include "recycling_allocator.h"
+#include "vector_algorithms.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Максимальный размер контейнера в бенчмарках. Полный прогон до 100M элементов требует
+// десятков гигабайт памяти, поэтому отдельные наборы удобно выбирать через --benchmark_filter
+#ifndef VECTOR_BENCH_MAX_SIZE
+#define VECTOR_BENCH_MAX_SIZE 100'000'000
+#endif
+
+namespace {
+
+struct Pod64 {
+    explicit Pod64(uint64_t seed) noexcept {
+        for (auto& word : words) {
+            word = seed++;
+        }
+    }
+
+    uint64_t words[8];
+};
+
+static_assert(sizeof(Pod64) == 64);
+
+// Тип с потенциально выбрасывающим конструктором перемещения: при перевыделении памяти
+// контейнеры вынуждены копировать такие элементы, чтобы сохранить строгую гарантию
+struct ThrowingMove {
+    explicit ThrowingMove(uint64_t seed)
+        : text(std::to_string(seed) + "-throwing-move-payload") {
+    }
+
+    ThrowingMove(const ThrowingMove&) = default;
+    ThrowingMove& operator=(const ThrowingMove&) = default;
+
+    ThrowingMove(ThrowingMove&& other) noexcept(false)
+        : text(std::move(other.text)) {
+    }
+
+    ThrowingMove& operator=(ThrowingMove&& other) noexcept(false) {
+        text = std::move(other.text);
+        return *this;
+    }
+
+    std::string text;
+};
+
+template <typename T>
+T MakeValue(uint64_t seed) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        // Длина выбрана больше буфера SSO, чтобы каждая строка владела динамической памятью
+        return std::to_string(seed) + "-string-payload-beyond-sso";
+    } else {
+        return T(seed);
+    }
+}
+
+template <typename T>
+uint64_t Weight(const T& value) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return value.size();
+    } else if constexpr (std::is_same_v<T, ThrowingMove>) {
+        return value.text.size();
+    } else if constexpr (std::is_same_v<T, Pod64>) {
+        return value.words[0];
+    } else {
+        return static_cast<uint64_t>(value);
+    }
+}
+
+// Единый интерфейс для std::vector и Vector
+
+template <typename T>
+void PushBack(std::vector<T>& v, const T& value) {
+    v.push_back(value);
+}
+
+template <typename T, typename... Params>
+void PushBack(Vector<T, Params...>& v, const T& value) {
+    v.PushBack(value);
+}
+
+template <typename T, typename... Args>
+void EmplaceBack(std::vector<T>& v, Args&&... args) {
+    v.emplace_back(std::forward<Args>(args)...);
+}
+
+template <typename T, typename... Params, typename... Args>
+void EmplaceBack(Vector<T, Params...>& v, Args&&... args) {
+    v.EmplaceBack(std::forward<Args>(args)...);
+}
+
+template <typename T>
+void Reserve(std::vector<T>& v, size_t capacity) {
+    v.reserve(capacity);
+}
+
+template <typename T, typename... Params>
+void Reserve(Vector<T, Params...>& v, size_t capacity) {
+    v.Reserve(capacity);
+}
+
+template <typename T>
+void Clear(std::vector<T>& v) {
+    v.clear();
+}
+
+template <typename T, typename... Params>
+void Clear(Vector<T, Params...>& v) {
+    v.Clear();
+}
+
+template <typename T>
+void InsertAt(std::vector<T>& v, size_t index, const T& value) {
+    v.insert(v.begin() + index, value);
+}
+
+template <typename T, typename... Params>
+void InsertAt(Vector<T, Params...>& v, size_t index, const T& value) {
+    v.Insert(v.cbegin() + index, value);
+}
+
+template <typename T>
+void EraseAt(std::vector<T>& v, size_t index) {
+    v.erase(v.begin() + index);
+}
+
+template <typename T, typename... Params>
+void EraseAt(Vector<T, Params...>& v, size_t index) {
+    v.Erase(v.cbegin() + index);
+}
+
+template <typename Container>
+Container MakeContainer(size_t size) {
+    using T = typename std::iterator_traits<typename Container::iterator>::value_type;
+    Container v;
+    Reserve(v, size);
+    for (size_t i = 0; i < size; ++i) {
+        PushBack(v, MakeValue<T>(i));
+    }
+    return v;
+}
+
+template <typename Container>
+void BM_PushBack(benchmark::State& state) {
+    using T = typename std::iterator_traits<typename Container::iterator>::value_type;
+    const size_t size = static_cast<size_t>(state.range(0));
+    const T value = MakeValue<T>(size);
+    for (auto _ : state) {
+        Container v;
+        for (size_t i = 0; i < size; ++i) {
+            PushBack(v, value);
+        }
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Container>
+void BM_EmplaceBack(benchmark::State& state) {
+    using T = typename std::iterator_traits<typename Container::iterator>::value_type;
+    const size_t size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        Container v;
+        for (size_t i = 0; i < size; ++i) {
+            if constexpr (std::is_same_v<T, std::string>) {
+                EmplaceBack(v, size_t{32}, 'x');
+            } else if constexpr (std::is_same_v<T, int>) {
+                EmplaceBack(v, static_cast<int>(i));
+            } else {
+                EmplaceBack(v, static_cast<uint64_t>(i));
+            }
+        }
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Добавление в заранее зарезервированный контейнер: измеряет только горячий путь без перевыделений
+template <typename Container>
+void BM_EmplaceBackReserved(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    Container v;
+    Reserve(v, size);
+    for (auto _ : state) {
+        Clear(v);
+        for (size_t i = 0; i < size; ++i) {
+            EmplaceBack(v, static_cast<uint64_t>(i));
+        }
+        benchmark::DoNotOptimize(&*v.begin());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Создание и разрушение вектора одного и того же размера, как в обработчике запросов
+template <typename Container>
+void BM_ShortLivedVector(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        Container v(size);
+        benchmark::DoNotOptimize(v.Data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Снимок вектора для читателя: копия и чтение первого элемента
+template <typename Container>
+void BM_SnapshotCopy(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    const Container source{Vector<uint64_t>(size)};
+    for (auto _ : state) {
+        Container snapshot = source;
+        benchmark::DoNotOptimize(snapshot[0]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Время переноса size элементов в буфер удвоенной вместимости
+template <typename Container>
+void BM_ReserveRegrowth(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container v = MakeContainer<Container>(size);
+        state.ResumeTiming();
+        Reserve(v, size * 2);
+        benchmark::DoNotOptimize(v);
+        state.PauseTiming();
+        v = Container();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Вставка в середину и последующее удаление, сохраняющее размер контейнера
+template <typename Container>
+void BM_InsertEraseMiddle(benchmark::State& state) {
+    using T = typename std::iterator_traits<typename Container::iterator>::value_type;
+    const size_t size = static_cast<size_t>(state.range(0));
+    Container v = MakeContainer<Container>(size);
+    Reserve(v, size + 1);
+    const T value = MakeValue<T>(size);
+    for (auto _ : state) {
+        InsertAt(v, size / 2, value);
+        EraseAt(v, size / 2);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+template <typename Container>
+void BM_CopyAssign(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    const Container source = MakeContainer<Container>(size);
+    Container destination;
+    for (auto _ : state) {
+        destination = source;
+        benchmark::DoNotOptimize(destination);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Container>
+void BM_Iterate(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    const Container v = MakeContainer<Container>(size);
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (const auto& value : v) {
+            sum += Weight(value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Копирование вектора последовательно и в нескольких потоках
+template <typename T, bool Parallel>
+void BM_CopyConstruct(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    const Vector<T> source = MakeContainer<Vector<T>>(size);
+    for (auto _ : state) {
+        if constexpr (Parallel) {
+            Vector<T> copy(source, parallel);
+            benchmark::DoNotOptimize(copy);
+        } else {
+            Vector<T> copy(source);
+            benchmark::DoNotOptimize(copy);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Добавление из нескольких потоков в общий вектор под мьютексом и в ConcurrentVector
+template <bool Concurrent>
+void BM_SharedPushBack(benchmark::State& state) {
+    static Vector<uint64_t> locked;
+    static std::mutex mutex;
+    static ConcurrentVector<uint64_t>* concurrent = nullptr;
+    if (state.thread_index() == 0) {
+        locked = Vector<uint64_t>();
+        concurrent = new ConcurrentVector<uint64_t>();
+    }
+    uint64_t value = 0;
+    for (auto _ : state) {
+        if constexpr (Concurrent) {
+            concurrent->PushBack(value++);
+        } else {
+            std::lock_guard guard(mutex);
+            locked.PushBack(value++);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        delete concurrent;
+    }
+}
+
+// Сумма элементов последовательным циклом и векторизованным Sum
+template <typename T, bool Simd>
+void BM_Sum(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    Vector<T> v(size);
+    for (size_t i = 0; i < size; ++i) {
+        v[i] = static_cast<T>(i % 128);
+    }
+    for (auto _ : state) {
+        if constexpr (Simd) {
+            benchmark::DoNotOptimize(Sum(v));
+        } else {
+            detail::SumType<T> sum = 0;
+            for (const T value : v) {
+                sum += value;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Поиск по ключу в узловом std::map и в FlatMap
+template <typename Map>
+void BM_MapFind(benchmark::State& state) {
+    const uint64_t size = static_cast<uint64_t>(state.range(0));
+    Map map;
+    for (uint64_t i = 0; i < size; ++i) {
+        map[i * 2] = i;
+    }
+    uint64_t key = 0;
+    for (auto _ : state) {
+        // Шаг по простому модулю обходит ключи вразброс, как случайные запросы
+        key = (key + 7919) % (size * 2);
+        if constexpr (std::is_same_v<Map, std::map<uint64_t, uint64_t>>) {
+            benchmark::DoNotOptimize(map.find(key));
+        } else {
+            benchmark::DoNotOptimize(map.Find(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Очередь FIFO постоянной длины на Vector с удалением из начала и на RingVector
+template <typename Queue>
+void BM_Fifo(benchmark::State& state) {
+    const uint64_t size = static_cast<uint64_t>(state.range(0));
+    Queue queue;
+    for (uint64_t i = 0; i < size; ++i) {
+        queue.PushBack(i);
+    }
+    uint64_t value = size;
+    for (auto _ : state) {
+        if constexpr (std::is_same_v<Queue, Vector<uint64_t>>) {
+            queue.Erase(queue.begin());
+        } else {
+            queue.PopFront();
+        }
+        queue.PushBack(value++);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void ApplySizes(benchmark::internal::Benchmark* benchmark) {
+    const int64_t max_size = VECTOR_BENCH_MAX_SIZE;
+    for (int64_t size = 8; size < max_size; size *= 8) {
+        benchmark->Arg(size);
+    }
+    benchmark->Arg(max_size);
+}
+
+}  // namespace
+
+#define VECTOR_BENCHMARK_FOR(Function, T)                             \
+    BENCHMARK_TEMPLATE(Function, std::vector<T>)->Apply(ApplySizes); \
+    BENCHMARK_TEMPLATE(Function, Vector<T>)->Apply(ApplySizes)
+
+#define VECTOR_BENCHMARK(Function)                \
+    VECTOR_BENCHMARK_FOR(Function, int);          \
+    VECTOR_BENCHMARK_FOR(Function, std::string);  \
+    VECTOR_BENCHMARK_FOR(Function, Pod64);        \
+    VECTOR_BENCHMARK_FOR(Function, ThrowingMove)
+
+VECTOR_BENCHMARK(BM_PushBack);
+VECTOR_BENCHMARK(BM_EmplaceBack);
+BENCHMARK_TEMPLATE(BM_EmplaceBackReserved, std::vector<uint64_t>)->Apply(ApplySizes);
+BENCHMARK_TEMPLATE(BM_EmplaceBackReserved, Vector<uint64_t>)->Apply(ApplySizes);
+BENCHMARK_TEMPLATE(BM_EmplaceBackReserved, std::vector<Pod64>)->Apply(ApplySizes);
+BENCHMARK_TEMPLATE(BM_EmplaceBackReserved, Vector<Pod64>)->Apply(ApplySizes);
+VECTOR_BENCHMARK(BM_ReserveRegrowth);
+// С BasicRelocation элементы с выбрасывающим перемещением переносятся перемещением, а не копированием
+BENCHMARK_TEMPLATE(BM_ReserveRegrowth, BasicRelocationVector<ThrowingMove>)->Apply(ApplySizes);
+VECTOR_BENCHMARK(BM_InsertEraseMiddle);
+VECTOR_BENCHMARK(BM_CopyAssign);
+VECTOR_BENCHMARK(BM_Iterate);
+
+BENCHMARK_TEMPLATE(BM_CopyConstruct, std::string, false)->Apply(ApplySizes)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CopyConstruct, std::string, true)->Apply(ApplySizes)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CopyConstruct, Pod64, false)->Apply(ApplySizes)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CopyConstruct, Pod64, true)->Apply(ApplySizes)->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_SharedPushBack, false)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SharedPushBack, true)->ThreadRange(1, 32)->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_Sum, int, false)->Apply(ApplySizes);
+BENCHMARK_TEMPLATE(BM_Sum, int, true)->Apply(ApplySizes);
+BENCHMARK_TEMPLATE(BM_Sum, float, false)->Apply(ApplySizes);
+BENCHMARK_TEMPLATE(BM_Sum, float, true)->Apply(ApplySizes);
+
+BENCHMARK_TEMPLATE(BM_MapFind, std::map<uint64_t, uint64_t>)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_MapFind, FlatMap<uint64_t, uint64_t>)->RangeMultiplier(8)->Range(8, 1 << 18);
+
+BENCHMARK_TEMPLATE(BM_Fifo, Vector<uint64_t>)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK_TEMPLATE(BM_Fifo, RingVector<uint64_t>)->RangeMultiplier(8)->Range(8, 1 << 15);
+
+BENCHMARK_TEMPLATE(BM_ShortLivedVector, Vector<uint64_t>)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK_TEMPLATE(BM_ShortLivedVector, RecyclingVector<uint64_t>)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK_TEMPLATE(BM_SnapshotCopy, Vector<uint64_t>)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK_TEMPLATE(BM_SnapshotCopy, CowVector<uint64_t>)->RangeMultiplier(8)->Range(8, 1 << 15);
+
+BENCHMARK_MAIN();
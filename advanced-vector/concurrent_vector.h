@@ -0,0 +1,183 @@
+#pragma once
+#include "segmented_vector.h"
+
+#include <atomic>
+#include <memory>
+
+// Вектор, допускающий одновременное добавление элементов из многих потоков и чтение опубликованных
+// элементов. Индекс нового элемента резервируется одной атомарной операцией fetch_add, элементы
+// хранятся в сегментах SegmentLayout и никогда не перемещаются. Size() возвращает опубликованный
+// размер: длину префикса, все элементы которого уже сконструированы. Поток, закончивший
+// конструирование, продвигает опубликованный размер через готовые элементы, никого не ожидая.
+// Поскольку пропуск в префиксе сделал бы следующие элементы недоступными, элементы должны
+// конструироваться без исключений. Удаление элементов не поддерживается. Через Alloc выделяются
+// и элементы, и служебные данные сегментов
+template <typename T, typename Alloc = std::allocator<T>, size_t FirstSegmentSize = 64>
+class ConcurrentVector {
+    using AllocTraits = std::allocator_traits<Alloc>;
+    using Layout = detail::SegmentLayout<FirstSegmentSize>;
+    using FlagAlloc = typename AllocTraits::template rebind_alloc<std::atomic<bool>>;
+
+    struct Segment;
+    using SegmentAlloc = typename AllocTraits::template rebind_alloc<Segment>;
+    using SegmentAllocTraits = std::allocator_traits<SegmentAlloc>;
+
+public:
+    using allocator_type = Alloc;
+
+    ConcurrentVector() = default;
+
+    explicit ConcurrentVector(const Alloc& alloc) noexcept
+        : alloc_(alloc)
+    {
+    }
+
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    // Вызывается, когда все добавляющие потоки завершили работу
+    ~ConcurrentVector() {
+        const size_t size = Size();
+        for (size_t segment = 0; segment < Layout::kMaxSegments; ++segment) {
+            Segment* data = segments_[segment].load(std::memory_order_acquire);
+            if (data == nullptr) {
+                continue;
+            }
+            const size_t first = Layout::CapacityOf(segment);
+            if (first < size) {
+                detail::DestroyN(alloc_, data->elements.GetAddress(),
+                                 std::min(size - first, Layout::SegmentSize(segment)));
+            }
+            DeleteSegment(data);
+        }
+    }
+
+    // Заранее выделяет сегменты для new_capacity элементов
+    void Reserve(size_t new_capacity) {
+        for (size_t segment = 0; Layout::CapacityOf(segment) < new_capacity; ++segment) {
+            EnsureSegment(segment);
+        }
+    }
+
+    // Добавляет элемент и возвращает его индекс. Сегмент для очередного индекса выделяется до его
+    // резервирования, поэтому при нехватке памяти выбрасывается std::bad_alloc, а вектор не меняется.
+    // Если несколько потоков одновременно пересекут границу сегмента и память закончится именно
+    // в этот момент, программа будет завершена
+    template <typename... Args>
+    size_t EmplaceBack(Args&&... args) {
+        static_assert(std::is_nothrow_constructible_v<T, Args&&...>,
+                      "ConcurrentVector requires elements to be constructed without exceptions");
+        EnsureSegment(Layout::SegmentOf(reserved_.load(std::memory_order_relaxed)));
+        const size_t index = reserved_.fetch_add(1, std::memory_order_relaxed);
+        Publish(index, std::forward<Args>(args)...);
+        return index;
+    }
+
+    size_t PushBack(T&& value) {
+        return EmplaceBack(std::move(value));
+    }
+
+    size_t PushBack(const T& value) {
+        return EmplaceBack(value);
+    }
+
+    // Опубликованный размер. Элементы с меньшими индексами можно читать из любого потока
+    size_t Size() const noexcept {
+        return published_.load(std::memory_order_acquire);
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < reserved_.load(std::memory_order_relaxed));
+        const size_t segment = Layout::SegmentOf(index);
+        const Segment* data = segments_[segment].load(std::memory_order_acquire);
+        return data->elements[Layout::OffsetOf(index, segment)];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < reserved_.load(std::memory_order_relaxed));
+        const size_t segment = Layout::SegmentOf(index);
+        Segment* data = segments_[segment].load(std::memory_order_acquire);
+        return data->elements[Layout::OffsetOf(index, segment)];
+    }
+
+    allocator_type GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+private:
+    struct Segment {
+        Segment(size_t capacity, const Alloc& alloc)
+            : elements(capacity, alloc)
+            , ready(capacity, FlagAlloc(alloc)) {
+            for (size_t i = 0; i < capacity; ++i) {
+                ::new (static_cast<void*>(ready + i)) std::atomic<bool>(false);
+            }
+        }
+
+        RawMemory<T, Alloc> elements;
+        // Признаки завершённого конструирования элементов. std::atomic<bool> тривиально
+        // разрушается, поэтому признаки освобождаются вместе с памятью без вызова деструкторов
+        RawMemory<std::atomic<bool>, FlagAlloc> ready;
+    };
+
+    Segment* NewSegment(size_t capacity) {
+        SegmentAlloc alloc(alloc_);
+        Segment* data = SegmentAllocTraits::allocate(alloc, 1);
+        try {
+            SegmentAllocTraits::construct(alloc, data, capacity, alloc_);
+        } catch (...) {
+            SegmentAllocTraits::deallocate(alloc, data, 1);
+            throw;
+        }
+        return data;
+    }
+
+    void DeleteSegment(Segment* data) noexcept {
+        SegmentAlloc alloc(alloc_);
+        SegmentAllocTraits::destroy(alloc, data);
+        SegmentAllocTraits::deallocate(alloc, data, 1);
+    }
+
+    Segment* EnsureSegment(size_t segment) {
+        Segment* data = segments_[segment].load(std::memory_order_acquire);
+        if (data != nullptr) {
+            return data;
+        }
+        Segment* candidate = NewSegment(Layout::SegmentSize(segment));
+        if (segments_[segment].compare_exchange_strong(data, candidate, std::memory_order_acq_rel)) {
+            return candidate;
+        }
+        // Сегмент успел выделить другой поток
+        DeleteSegment(candidate);
+        return data;
+    }
+
+    template <typename... Args>
+    void Publish(size_t index, Args&&... args) noexcept {
+        const size_t segment = Layout::SegmentOf(index);
+        const size_t offset = Layout::OffsetOf(index, segment);
+        Segment* data = EnsureSegment(segment);
+        AllocTraits::construct(alloc_, data->elements + offset, std::forward<Args>(args)...);
+        data->ready[offset].store(true);
+
+        // Сохранение признака и чтение опубликованного размера упорядочены последовательно:
+        // либо этот поток увидит чужое продвижение до index, либо тот поток увидит признак
+        size_t published = published_.load();
+        while (published < reserved_.load() && IsReady(published)) {
+            if (published_.compare_exchange_weak(published, published + 1)) {
+                ++published;
+            }
+        }
+    }
+
+    bool IsReady(size_t index) const noexcept {
+        const size_t segment = Layout::SegmentOf(index);
+        const Segment* data = segments_[segment].load();
+        return data != nullptr && data->ready[Layout::OffsetOf(index, segment)].load();
+    }
+
+    Alloc alloc_;
+    std::atomic<Segment*> segments_[Layout::kMaxSegments] = {};
+    std::atomic<size_t> reserved_{0};
+    std::atomic<size_t> published_{0};
+};
@@ -0,0 +1,162 @@
+#pragma once
+#include "span.h"
+#include "vector.h"
+
+#include <atomic>
+#include <memory>
+
+// Вектор с копированием при записи. Копии CowVector разделяют один буфер со счётчиком ссылок,
+// поэтому копирование стоит O(1) и не копирует элементы. Первое изменение копии, буфер которой
+// разделён с другими, создаёт её собственный экземпляр через конструктор копирования Vector.
+// Разные объекты CowVector, разделяющие буфер, можно копировать, читать и изменять из разных
+// потоков без синхронизации; один и тот же объект, как и Vector, требует внешней синхронизации.
+// Изменение делает недействительными указатели и ссылки, полученные через этот объект
+template <typename T, typename Alloc = std::allocator<T>>
+class CowVector {
+public:
+    using vector_type = Vector<T, Alloc>;
+    using const_iterator = const T*;
+    using iterator = const T*;
+
+    CowVector() noexcept = default;
+
+    // Забирает элементы vector без копирования
+    explicit CowVector(vector_type&& vector)
+        : data_(std::make_shared<vector_type>(std::move(vector)))
+    {
+    }
+
+    explicit CowVector(const vector_type& vector)
+        : data_(std::make_shared<vector_type>(vector))
+    {
+    }
+
+    // Разделяемый вектор только для чтения. Изменения выполняются через Mutate()
+    // и методы, которые к нему обращаются
+    const vector_type& Get() const noexcept {
+        return data_ != nullptr ? *data_ : EmptyVector();
+    }
+
+    // Возвращает вектор, не разделённый с другими копиями, копируя элементы, если это необходимо.
+    // Ссылка действительна до копирования или присваивания этого объекта
+    vector_type& Mutate() {
+        if (data_ == nullptr) {
+            data_ = std::make_shared<vector_type>();
+        } else if (data_.use_count() != 1) {
+            data_ = std::make_shared<vector_type>(*data_);
+        } else {
+            // Другой владелец мог только что отпустить буфер. Его чтения элементов должны
+            // завершиться до изменений этого объекта, которые начнутся после ограды
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *data_;
+    }
+
+    // Признак того, что буфер разделён с другими копиями
+    bool IsShared() const noexcept {
+        return data_ != nullptr && data_.use_count() > 1;
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        return Mutate().EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    void PushBack(const T& value) {
+        Mutate().PushBack(value);
+    }
+
+    void PushBack(T&& value) {
+        Mutate().PushBack(std::move(value));
+    }
+
+    void PopBack() {
+        Mutate().PopBack();
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size == 0) {
+            Clear();
+        } else {
+            Mutate().Resize(new_size);
+        }
+    }
+
+    void Reserve(size_t new_capacity) {
+        Mutate().Reserve(new_capacity);
+    }
+
+    // Изменяет элемент index, предварительно отделяя буфер
+    T& MutableAt(size_t index) {
+        return Mutate().At(index);
+    }
+
+    // Отпускает буфер, не копируя его, даже если он разделён
+    void Clear() noexcept {
+        data_.reset();
+    }
+
+    const_iterator begin() const noexcept {
+        return Get().begin();
+    }
+
+    const_iterator end() const noexcept {
+        return Get().end();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    size_t Size() const noexcept {
+        return Get().Size();
+    }
+
+    bool Empty() const noexcept {
+        return Size() == 0;
+    }
+
+    size_t Capacity() const noexcept {
+        return Get().Capacity();
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return Get()[index];
+    }
+
+    const T& At(size_t index) const {
+        return Get().At(index);
+    }
+
+    const T* Data() const noexcept {
+        return Get().Data();
+    }
+
+    Span<const T> AsSpan() const noexcept {
+        return Get().AsSpan();
+    }
+
+    void Swap(CowVector& other) noexcept {
+        data_.swap(other.data_);
+    }
+
+    friend bool operator==(const CowVector& lhs, const CowVector& rhs) {
+        return lhs.data_ == rhs.data_ || lhs.Get() == rhs.Get();
+    }
+
+    friend bool operator!=(const CowVector& lhs, const CowVector& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    static const vector_type& EmptyVector() noexcept {
+        static const vector_type empty;
+        return empty;
+    }
+
+    std::shared_ptr<vector_type> data_;
+};
@@ -0,0 +1,360 @@
+#pragma once
+#include "flat_set.h"
+
+#include <stdexcept>
+
+namespace detail {
+
+// Сравнивает пары ключ-значение по ключу. Один из аргументов может быть самим ключом. Ключ берётся
+// только из элементов типа Value, поэтому ключи, которые сами являются парами, сравниваются целиком
+template <typename Compare, typename Value>
+struct PairKeyCompare {
+    bool operator()(const Value& lhs, const Value& rhs) const {
+        return compare(lhs.first, rhs.first);
+    }
+
+    template <typename K>
+    bool operator()(const Value& lhs, const K& rhs) const {
+        return compare(lhs.first, rhs);
+    }
+
+    template <typename K>
+    bool operator()(const K& lhs, const Value& rhs) const {
+        return compare(lhs, rhs.first);
+    }
+
+    Compare compare;
+};
+
+}  // namespace detail
+
+// Упорядоченный ассоциативный массив с уникальными ключами, хранящий пары ключ-значение подряд
+// в векторе, как FlatSet. Ключи нельзя изменять через итераторы: это нарушит порядок элементов.
+// Вставка и удаление делают недействительными итераторы и ссылки на элементы
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Container = Vector<std::pair<Key, Value>>>
+class FlatMap {
+    using PairCompare = detail::PairKeyCompare<Compare, std::pair<Key, Value>>;
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using key_compare = Compare;
+    using container_type = Container;
+    using iterator = typename Container::iterator;
+    using const_iterator = typename Container::const_iterator;
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& compare)
+        : compare_{compare}
+    {
+    }
+
+    template <typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+    FlatMap(InputIt first, InputIt last, const Compare& compare = Compare())
+        : compare_{compare}
+    {
+        Insert(first, last);
+    }
+
+    // Принимает диапазон, уже упорядоченный по ключам без повторов
+    template <typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+    FlatMap(SortedUniqueTag, InputIt first, InputIt last, const Compare& compare = Compare())
+        : elements_(first, last)
+        , compare_{compare}
+    {
+        assert(IsSortedUnique());
+    }
+
+    FlatMap(std::initializer_list<value_type> elements, const Compare& compare = Compare())
+        : FlatMap(elements.begin(), elements.end(), compare)
+    {
+    }
+
+    // Вставляет пару, если элемента с таким ключом нет. Возвращает позицию элемента и признак вставки
+    std::pair<iterator, bool> Insert(const value_type& value) {
+        return TryEmplace(value.first, value.second);
+    }
+
+    std::pair<iterator, bool> Insert(value_type&& value) {
+        return TryEmplace(std::move(value.first), std::move(value.second));
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> Emplace(Args&&... args) {
+        value_type value(std::forward<Args>(args)...);
+        return Insert(std::move(value));
+    }
+
+    // Вставляет элемент с ключом key и значением из args, только если такого ключа ещё нет.
+    // Если ключ уже есть, args не используются
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> TryEmplace(K&& key, Args&&... args) {
+        const iterator pos = LowerBound(key);
+        if (pos != end() && !compare_(key, *pos)) {
+            return {pos, false};
+        }
+        return {elements_.Emplace(pos, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                                  std::forward_as_tuple(std::forward<Args>(args)...)),
+                true};
+    }
+
+    // Вставляет элемент или присваивает новое значение элементу с ключом key
+    template <typename K, typename V>
+    std::pair<iterator, bool> InsertOrAssign(K&& key, V&& value) {
+        const iterator pos = LowerBound(key);
+        if (pos != end() && !compare_(key, *pos)) {
+            pos->second = std::forward<V>(value);
+            return {pos, false};
+        }
+        return {elements_.Emplace(pos, std::forward<K>(key), std::forward<V>(value)), true};
+    }
+
+    // Вставляет пары диапазона за один проход слияния, как FlatSet::Insert, с теми же гарантиями
+    // при исключениях. Из пар с равными ключами остаётся прежний элемент, а среди новых - первый
+    // в диапазоне
+    template <typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+    void Insert(InputIt first, InputIt last) {
+        detail::InsertSortedRange(elements_, first, last, compare_);
+    }
+
+    void Insert(std::initializer_list<value_type> elements) {
+        Insert(elements.begin(), elements.end());
+    }
+
+    // Значение по ключу key. Если ключа нет, вставляет значение, инициализированное по умолчанию
+    Value& operator[](const Key& key) {
+        return TryEmplace(key).first->second;
+    }
+
+    Value& operator[](Key&& key) {
+        return TryEmplace(std::move(key)).first->second;
+    }
+
+    // Если ключа нет, выбрасывает std::out_of_range
+    Value& At(const Key& key) {
+        return AtKey(*this, key);
+    }
+
+    const Value& At(const Key& key) const {
+        return AtKey(*this, key);
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    Value& At(const K& key) {
+        return AtKey(*this, key);
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    const Value& At(const K& key) const {
+        return AtKey(*this, key);
+    }
+
+    iterator Erase(const_iterator pos) {
+        return elements_.Erase(pos);
+    }
+
+    iterator Erase(const_iterator first, const_iterator last) {
+        return elements_.Erase(first, last);
+    }
+
+    // Удаляет элемент с ключом key и возвращает число удалённых элементов
+    size_t Erase(const Key& key) {
+        return EraseKey(key);
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    size_t Erase(const K& key) {
+        return EraseKey(key);
+    }
+
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred) {
+        return elements_.EraseIf(pred);
+    }
+
+    iterator Find(const Key& key) {
+        return FindKey(*this, key);
+    }
+
+    const_iterator Find(const Key& key) const {
+        return FindKey(*this, key);
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    iterator Find(const K& key) {
+        return FindKey(*this, key);
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    const_iterator Find(const K& key) const {
+        return FindKey(*this, key);
+    }
+
+    bool Contains(const Key& key) const {
+        return Find(key) != end();
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    bool Contains(const K& key) const {
+        return Find(key) != end();
+    }
+
+    size_t Count(const Key& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    size_t Count(const K& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    // Первый элемент с ключом, не меньшим key
+    iterator LowerBound(const Key& key) {
+        return std::lower_bound(begin(), end(), key, compare_);
+    }
+
+    const_iterator LowerBound(const Key& key) const {
+        return std::lower_bound(begin(), end(), key, compare_);
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    iterator LowerBound(const K& key) {
+        return std::lower_bound(begin(), end(), key, compare_);
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    const_iterator LowerBound(const K& key) const {
+        return std::lower_bound(begin(), end(), key, compare_);
+    }
+
+    // Первый элемент с ключом, большим key
+    iterator UpperBound(const Key& key) {
+        return std::upper_bound(begin(), end(), key, compare_);
+    }
+
+    const_iterator UpperBound(const Key& key) const {
+        return std::upper_bound(begin(), end(), key, compare_);
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    iterator UpperBound(const K& key) {
+        return std::upper_bound(begin(), end(), key, compare_);
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    const_iterator UpperBound(const K& key) const {
+        return std::upper_bound(begin(), end(), key, compare_);
+    }
+
+    void Reserve(size_t new_capacity) {
+        elements_.Reserve(new_capacity);
+    }
+
+    void ShrinkToFit() {
+        elements_.ShrinkToFit();
+    }
+
+    void Clear() noexcept {
+        elements_.Clear();
+    }
+
+    // Забирает вектор пар, оставляя массив пустым
+    Container Extract() noexcept(std::is_nothrow_move_constructible_v<Container>) {
+        Container elements(std::move(elements_));
+        elements_.Clear();
+        return elements;
+    }
+
+    iterator begin() noexcept {
+        return elements_.begin();
+    }
+
+    iterator end() noexcept {
+        return elements_.end();
+    }
+
+    const_iterator begin() const noexcept {
+        return elements_.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return elements_.end();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    size_t Size() const noexcept {
+        return elements_.Size();
+    }
+
+    bool Empty() const noexcept {
+        return elements_.Size() == 0;
+    }
+
+    size_t Capacity() const noexcept {
+        return elements_.Capacity();
+    }
+
+    key_compare KeyComp() const {
+        return compare_.compare;
+    }
+
+    void Swap(FlatMap& other) noexcept {
+        using std::swap;
+        elements_.Swap(other.elements_);
+        swap(compare_, other.compare_);
+    }
+
+    friend bool operator==(const FlatMap& lhs, const FlatMap& rhs) {
+        return lhs.elements_ == rhs.elements_;
+    }
+
+    friend bool operator!=(const FlatMap& lhs, const FlatMap& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    // Общая реализация константного и неконстантного поиска
+    template <typename Self, typename K>
+    static auto FindKey(Self& self, const K& key) {
+        const auto pos = self.LowerBound(key);
+        return pos != self.end() && !self.compare_(key, *pos) ? pos : self.end();
+    }
+
+    template <typename Self, typename K>
+    static auto& AtKey(Self& self, const K& key) {
+        const auto pos = FindKey(self, key);
+        if (pos == self.end()) {
+            throw std::out_of_range("FlatMap: key not found");
+        }
+        return pos->second;
+    }
+
+    template <typename K>
+    size_t EraseKey(const K& key) {
+        const iterator pos = Find(key);
+        if (pos == end()) {
+            return 0;
+        }
+        elements_.Erase(pos);
+        return 1;
+    }
+
+    bool IsSortedUnique() const {
+        return std::adjacent_find(begin(), end(), [this](const value_type& lhs, const value_type& rhs) {
+            return !compare_(lhs, rhs);
+        }) == end();
+    }
+
+    Container elements_;
+    PairCompare compare_;
+};
@@ -0,0 +1,305 @@
+#pragma once
+#include "vector.h"
+
+#include <initializer_list>
+
+// Признак того, что диапазон уже упорядочен по возрастанию ключей и не содержит повторов
+struct SortedUniqueTag {
+    explicit SortedUniqueTag() = default;
+};
+
+inline constexpr SortedUniqueTag sorted_unique{};
+
+namespace detail {
+
+template <typename Compare, typename = void>
+struct IsTransparent : std::false_type {};
+
+template <typename Compare>
+struct IsTransparent<Compare, std::void_t<typename Compare::is_transparent>> : std::true_type {};
+
+// Разрешает перегрузки поиска по ключу другого типа, если компаратор прозрачный
+template <typename Compare, typename Key>
+using EnableTransparentT = std::enable_if_t<IsTransparent<Compare>::value, Key>;
+
+// Добавляет элементы диапазона в конец упорядоченного контейнера, упорядочивает их, сливает
+// с прежними элементами и удаляет повторы. Сортировка и слияние устойчивы, поэтому из равных
+// ключей остаётся прежний элемент, а среди новых - первый в диапазоне. Пока прежние элементы
+// не затронуты (копирование и сортировка новых), исключение удаляет только добавленные элементы.
+// Исключение из слияния или удаления повторов, переставляющих прежние элементы, очищает контейнер
+template <typename Container, typename InputIt, typename Less>
+void InsertSortedRange(Container& container, InputIt first, InputIt last, Less less) {
+    const size_t old_size = container.Size();
+    try {
+        container.Append(first, last);
+        std::stable_sort(container.begin() + old_size, container.end(), less);
+    } catch (...) {
+        container.Erase(container.begin() + old_size, container.end());
+        throw;
+    }
+    const auto middle = container.begin() + old_size;
+    if (middle == container.end()) {
+        return;
+    }
+    try {
+        if (old_size != 0 && less(*middle, *(middle - 1))) {
+            std::inplace_merge(container.begin(), middle, container.end(), less);
+        }
+        const auto new_end = std::unique(container.begin(), container.end(),
+                                         [less](const auto& lhs, const auto& rhs) {
+                                             return !less(lhs, rhs);
+                                         });
+        container.Erase(new_end, container.end());
+    } catch (...) {
+        container.Clear();
+        throw;
+    }
+}
+
+}  // namespace detail
+
+// Упорядоченное множество уникальных ключей, хранящихся подряд в векторе. Поиск - двоичный,
+// поэтому для небольших и средних таблиц он быстрее узловых контейнеров: ключи лежат в
+// соседних строках кэша и не требуют переходов по указателям. Вставка и удаление одного ключа
+// сдвигают хвост за O(n), поэтому большие наборы ключей следует вставлять одним диапазоном.
+// Вставка и удаление делают недействительными итераторы и ссылки на элементы
+template <typename Key, typename Compare = std::less<Key>, typename Container = Vector<Key>>
+class FlatSet {
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using container_type = Container;
+    using iterator = typename Container::const_iterator;
+    using const_iterator = typename Container::const_iterator;
+
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& compare)
+        : compare_(compare)
+    {
+    }
+
+    template <typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+    FlatSet(InputIt first, InputIt last, const Compare& compare = Compare())
+        : compare_(compare)
+    {
+        Insert(first, last);
+    }
+
+    // Принимает уже упорядоченный диапазон без повторов, не сортируя его повторно
+    template <typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+    FlatSet(SortedUniqueTag, InputIt first, InputIt last, const Compare& compare = Compare())
+        : keys_(first, last)
+        , compare_(compare)
+    {
+        assert(IsSortedUnique());
+    }
+
+    FlatSet(std::initializer_list<Key> keys, const Compare& compare = Compare())
+        : FlatSet(keys.begin(), keys.end(), compare)
+    {
+    }
+
+    // Вставляет ключ, если равного ему нет. Возвращает позицию ключа и признак вставки
+    std::pair<iterator, bool> Insert(const Key& key) {
+        return InsertUnique(key);
+    }
+
+    std::pair<iterator, bool> Insert(Key&& key) {
+        return InsertUnique(std::move(key));
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> Emplace(Args&&... args) {
+        return InsertUnique(Key(std::forward<Args>(args)...));
+    }
+
+    // Добавляет ключи диапазона в конец вектора, а затем один раз упорядочивает и сливает их
+    // с прежними ключами: вставка m ключей стоит O(m log m + n) вместо O(m * n). Если исключение
+    // выбросит копирование или сортировка новых ключей, множество не меняется. Исключение из
+    // сравнения или перемещения ключей во время слияния с прежними оставляет множество пустым
+    template <typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+    void Insert(InputIt first, InputIt last) {
+        detail::InsertSortedRange(keys_, first, last, compare_);
+    }
+
+    void Insert(std::initializer_list<Key> keys) {
+        Insert(keys.begin(), keys.end());
+    }
+
+    iterator Erase(const_iterator pos) {
+        return keys_.Erase(pos);
+    }
+
+    iterator Erase(const_iterator first, const_iterator last) {
+        return keys_.Erase(first, last);
+    }
+
+    // Удаляет ключ, равный key, и возвращает число удалённых ключей
+    size_t Erase(const Key& key) {
+        return EraseKey(key);
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    size_t Erase(const K& key) {
+        return EraseKey(key);
+    }
+
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred) {
+        return keys_.EraseIf(pred);
+    }
+
+    iterator Find(const Key& key) const {
+        return FindKey(key);
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    iterator Find(const K& key) const {
+        return FindKey(key);
+    }
+
+    bool Contains(const Key& key) const {
+        return FindKey(key) != end();
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    bool Contains(const K& key) const {
+        return FindKey(key) != end();
+    }
+
+    size_t Count(const Key& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    size_t Count(const K& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    // Первый ключ, не меньший key
+    iterator LowerBound(const Key& key) const {
+        return std::lower_bound(begin(), end(), key, compare_);
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    iterator LowerBound(const K& key) const {
+        return std::lower_bound(begin(), end(), key, compare_);
+    }
+
+    // Первый ключ, больший key
+    iterator UpperBound(const Key& key) const {
+        return std::upper_bound(begin(), end(), key, compare_);
+    }
+
+    template <typename K, typename = detail::EnableTransparentT<Compare, K>>
+    iterator UpperBound(const K& key) const {
+        return std::upper_bound(begin(), end(), key, compare_);
+    }
+
+    void Reserve(size_t new_capacity) {
+        keys_.Reserve(new_capacity);
+    }
+
+    void ShrinkToFit() {
+        keys_.ShrinkToFit();
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+    }
+
+    // Забирает вектор ключей, оставляя множество пустым
+    Container Extract() noexcept(std::is_nothrow_move_constructible_v<Container>) {
+        Container keys(std::move(keys_));
+        keys_.Clear();
+        return keys;
+    }
+
+    const_iterator begin() const noexcept {
+        return keys_.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return keys_.end();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    size_t Size() const noexcept {
+        return keys_.Size();
+    }
+
+    bool Empty() const noexcept {
+        return keys_.Size() == 0;
+    }
+
+    size_t Capacity() const noexcept {
+        return keys_.Capacity();
+    }
+
+    // Ключи в порядке возрастания
+    const Container& Keys() const noexcept {
+        return keys_;
+    }
+
+    key_compare KeyComp() const {
+        return compare_;
+    }
+
+    void Swap(FlatSet& other) noexcept {
+        using std::swap;
+        keys_.Swap(other.keys_);
+        swap(compare_, other.compare_);
+    }
+
+    friend bool operator==(const FlatSet& lhs, const FlatSet& rhs) {
+        return lhs.keys_ == rhs.keys_;
+    }
+
+    friend bool operator!=(const FlatSet& lhs, const FlatSet& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    template <typename K>
+    iterator FindKey(const K& key) const {
+        const iterator pos = LowerBound(key);
+        return pos != end() && !compare_(key, *pos) ? pos : end();
+    }
+
+    template <typename K>
+    size_t EraseKey(const K& key) {
+        const iterator pos = FindKey(key);
+        if (pos == end()) {
+            return 0;
+        }
+        keys_.Erase(pos);
+        return 1;
+    }
+
+    template <typename K>
+    std::pair<iterator, bool> InsertUnique(K&& key) {
+        const iterator pos = LowerBound(key);
+        if (pos != end() && !compare_(key, *pos)) {
+            return {pos, false};
+        }
+        return {keys_.Insert(pos, std::forward<K>(key)), true};
+    }
+
+    bool IsSortedUnique() const {
+        return std::adjacent_find(begin(), end(), [this](const Key& lhs, const Key& rhs) {
+            return !compare_(lhs, rhs);
+        }) == end();
+    }
+
+    Container keys_;
+    Compare compare_;
+};
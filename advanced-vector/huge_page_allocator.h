@@ -0,0 +1,216 @@
+#pragma once
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Способ отображения крупных блоков на большие страницы
+enum class HugePageMode {
+    // Обычные страницы
+    None,
+    // Прозрачные большие страницы: блок помечается madvise(MADV_HUGEPAGE)
+    Transparent,
+    // Явные страницы по 2 МиБ или 1 ГиБ из пула hugetlbfs (MAP_HUGETLB). Если пул исчерпан,
+    // блок отображается на прозрачные большие страницы
+    Explicit2MB,
+    Explicit1GB,
+};
+
+// Политика размещения страниц крупных блоков по узлам NUMA
+enum class NumaMode {
+    // Страницы размещаются на узле потока, первым обратившегося к ним
+    Default,
+    // Страницы размещаются только на узлах из маски
+    Bind,
+    // Страницы распределяются по узлам из маски поочерёдно
+    Interleave,
+};
+
+// Параметры размещения памяти для HugePageAllocator. Блоки меньше mmap_threshold байт
+// выделяются через malloc и параметрам не подчиняются
+struct MemoryPlacement {
+    HugePageMode huge_pages = HugePageMode::Transparent;
+    NumaMode numa = NumaMode::Default;
+    // Битовая маска узлов NUMA: бит i соответствует узлу i
+    unsigned long numa_nodes = 0;
+    size_t mmap_threshold = size_t{2} << 20;
+
+    bool operator==(const MemoryPlacement& other) const noexcept {
+        return huge_pages == other.huge_pages && numa == other.numa && numa_nodes == other.numa_nodes
+            && mmap_threshold == other.mmap_threshold;
+    }
+
+    bool operator!=(const MemoryPlacement& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+// Аллокатор, отображающий крупные блоки напрямую через mmap с учётом MemoryPlacement. Политика NUMA
+// назначается блоку через mbind до первого обращения к нему, поэтому элементы, сконструированные
+// любым потоком, окажутся на выбранных узлах. madvise и mbind служат подсказками: если ядро их
+// не поддерживает, блок остаётся с обычными страницами и политикой по умолчанию. Как и у
+// MallocAllocator, reallocate позволяет растить буфер тривиально перемещаемых элементов через mremap.
+// Вне Linux все блоки выделяются через malloc
+template <typename T>
+class HugePageAllocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "HugePageAllocator does not support over-aligned types");
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    HugePageAllocator() noexcept = default;
+
+    explicit HugePageAllocator(const MemoryPlacement& placement) noexcept
+        : placement_(placement) {
+    }
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>& other) noexcept
+        : placement_(other.GetPlacement()) {
+    }
+
+    const MemoryPlacement& GetPlacement() const noexcept {
+        return placement_;
+    }
+
+    T* allocate(size_t n) {
+        const size_t bytes = GetBytes(n);
+#if defined(__linux__)
+        if (IsMapped(bytes)) {
+            return static_cast<T*>(Map(RoundUpToPage(bytes)));
+        }
+#endif
+        void* p = std::malloc(bytes);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+#if defined(__linux__)
+        const size_t bytes = n * sizeof(T);
+        if (IsMapped(bytes)) {
+            munmap(p, RoundUpToPage(bytes));
+            return;
+        }
+#else
+        (void)n;
+#endif
+        std::free(p);
+    }
+
+    // Изменяет размер блока p с old_n до new_n элементов, сохраняя побайтово первые
+    // min(old_n, new_n) элементов. При нехватке памяти выбрасывает std::bad_alloc,
+    // оставляя исходный блок нетронутым
+    T* reallocate(T* p, size_t old_n, size_t new_n) {
+        const size_t new_bytes = GetBytes(new_n);
+#if defined(__linux__)
+        const size_t old_bytes = old_n * sizeof(T);
+        if (IsMapped(old_bytes) && IsMapped(new_bytes)) {
+            // Отображение переносится вместе с madvise и mbind, а явные большие страницы
+            // остаются таковыми, поскольку размеры кратны их размеру
+            void* q = mremap(p, RoundUpToPage(old_bytes), RoundUpToPage(new_bytes), MREMAP_MAYMOVE);
+            if (q == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(q);
+        }
+        if (IsMapped(old_bytes) || IsMapped(new_bytes)) {
+            T* q = allocate(new_n);
+            std::memcpy(static_cast<void*>(q), static_cast<const void*>(p), std::min(old_bytes, new_bytes));
+            deallocate(p, old_n);
+            return q;
+        }
+#else
+        (void)old_n;
+#endif
+        void* q = std::realloc(static_cast<void*>(p), new_bytes);
+        if (q == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(q);
+    }
+
+    template <typename U>
+    bool operator==(const HugePageAllocator<U>& other) const noexcept {
+        return placement_ == other.GetPlacement();
+    }
+
+    template <typename U>
+    bool operator!=(const HugePageAllocator<U>& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    static size_t GetBytes(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return n * sizeof(T);
+    }
+
+#if defined(__linux__)
+    // Значения политик из linux/mempolicy.h
+    static constexpr int kMpolBind = 2;
+    static constexpr int kMpolInterleave = 3;
+
+    bool IsMapped(size_t bytes) const noexcept {
+        return bytes >= placement_.mmap_threshold;
+    }
+
+    // Длина отображения кратна размеру страницы выбранного режима, даже если явные большие
+    // страницы оказались недоступны: так munmap и mremap всегда получают ту же длину, что и mmap
+    size_t RoundUpToPage(size_t bytes) const noexcept {
+        static const size_t system_page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t page_size = system_page_size;
+        if (placement_.huge_pages == HugePageMode::Explicit2MB) {
+            page_size = size_t{1} << 21;
+        } else if (placement_.huge_pages == HugePageMode::Explicit1GB) {
+            page_size = size_t{1} << 30;
+        }
+        return (bytes + page_size - 1) / page_size * page_size;
+    }
+
+    void* Map(size_t length) const {
+        constexpr int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        void* p = MAP_FAILED;
+        if (placement_.huge_pages == HugePageMode::Explicit2MB) {
+            p = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB | (21 << MAP_HUGE_SHIFT), -1, 0);
+        } else if (placement_.huge_pages == HugePageMode::Explicit1GB) {
+            p = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB | (30 << MAP_HUGE_SHIFT), -1, 0);
+        }
+        if (p == MAP_FAILED) {
+            p = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+            if (p == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            if (placement_.huge_pages != HugePageMode::None) {
+                madvise(p, length, MADV_HUGEPAGE);
+            }
+        }
+        if (placement_.numa != NumaMode::Default && placement_.numa_nodes != 0) {
+            const int mode = placement_.numa == NumaMode::Bind ? kMpolBind : kMpolInterleave;
+            const unsigned long nodes = placement_.numa_nodes;
+            syscall(SYS_mbind, p, length, mode, &nodes, sizeof(nodes) * CHAR_BIT + 1, 0);
+        }
+        return p;
+    }
+#endif
+
+    MemoryPlacement placement_;
+};
@@ -0,0 +1,128 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace detail {
+
+// Итератор произвольного доступа, хранящий индекс элемента в контейнере Container и обращающийся
+// к элементам через его operator[]. Подходит для контейнеров, элементы которых не лежат подряд
+template <typename Container, typename Value>
+class IndexIterator {
+    using Owner = std::conditional_t<std::is_const_v<Value>, const Container, Container>;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<Value>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value*;
+    using reference = Value&;
+
+    IndexIterator() noexcept = default;
+
+    IndexIterator(Owner* owner, size_t index) noexcept
+        : owner_(owner)
+        , index_(index) {
+    }
+
+    // iterator неявно преобразуется в const_iterator
+    template <typename Other, typename = std::enable_if_t<std::is_same_v<Other, value_type>
+                                                          && std::is_const_v<Value>>>
+    IndexIterator(const IndexIterator<Container, Other>& other) noexcept
+        : owner_(other.owner_)
+        , index_(other.index_) {
+    }
+
+    reference operator*() const noexcept {
+        return (*owner_)[index_];
+    }
+
+    pointer operator->() const noexcept {
+        return &**this;
+    }
+
+    reference operator[](difference_type offset) const noexcept {
+        return *(*this + offset);
+    }
+
+    IndexIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    IndexIterator operator++(int) noexcept {
+        IndexIterator copy = *this;
+        ++index_;
+        return copy;
+    }
+
+    IndexIterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+
+    IndexIterator operator--(int) noexcept {
+        IndexIterator copy = *this;
+        --index_;
+        return copy;
+    }
+
+    IndexIterator& operator+=(difference_type offset) noexcept {
+        index_ += offset;
+        return *this;
+    }
+
+    IndexIterator& operator-=(difference_type offset) noexcept {
+        index_ -= offset;
+        return *this;
+    }
+
+    friend IndexIterator operator+(IndexIterator it, difference_type offset) noexcept {
+        return it += offset;
+    }
+
+    friend IndexIterator operator+(difference_type offset, IndexIterator it) noexcept {
+        return it += offset;
+    }
+
+    friend IndexIterator operator-(IndexIterator it, difference_type offset) noexcept {
+        return it -= offset;
+    }
+
+    friend difference_type operator-(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ < rhs.index_;
+    }
+
+    friend bool operator>(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return rhs < lhs;
+    }
+
+    friend bool operator<=(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>=(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return !(lhs < rhs);
+    }
+
+private:
+    template <typename, typename>
+    friend class IndexIterator;
+
+    Owner* owner_ = nullptr;
+    size_t index_ = 0;
+};
+
+}  // namespace detail
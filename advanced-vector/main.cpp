@@ -1,8 +1,35 @@
 #include "vector.h"
+#include "malloc_allocator.h"
+#include "huge_page_allocator.h"
+#include "aligned_allocator.h"
+#include "small_vector.h"
+#include "soa_vector.h"
+#include "segmented_vector.h"
+#include "concurrent_vector.h"
+#include "mapped_vector.h"
+#include "vector_serialization.h"
+#include "vector_algorithms.h"
+#include "flat_set.h"
+#include "flat_map.h"
+#include "ring_vector.h"
+#include "static_vector.h"
+#include "recycling_allocator.h"
+#include "cow_vector.h"
+#include "vector_stats.h"
 
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -116,8 +143,164 @@ struct Obj {
     static inline int num_move_assigned = 0;
 };
 
+// Счётчики операций, выполненных через CountingAllocator
+struct AllocationCounters {
+    int num_allocations = 0;
+    int num_deallocations = 0;
+    size_t allocated_items = 0;
+    size_t deallocated_items = 0;
+};
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    explicit CountingAllocator(AllocationCounters* counters) noexcept
+        : counters(counters) {
+    }
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other) noexcept
+        : counters(other.counters) {
+    }
+
+    T* allocate(size_t n) {
+        ++counters->num_allocations;
+        counters->allocated_items += n;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        ++counters->num_deallocations;
+        counters->deallocated_items += n;
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>& other) const noexcept {
+        return counters == other.counters;
+    }
+
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>& other) const noexcept {
+        return !(*this == other);
+    }
+
+    AllocationCounters* counters;
+};
+
+// Крупный элемент с потокобезопасным счётчиком живых объектов для проверки параллельных операций
+struct Block {
+    Block() noexcept
+        : Block(0) {
+    }
+
+    explicit Block(int value) noexcept
+        : value(value) {
+        ++alive;
+    }
+
+    Block(const Block& other)
+        : value(other.value) {
+        if (other.value == throw_on_copy_value) {
+            throw std::runtime_error("Block copy exception");
+        }
+        ++alive;
+    }
+
+    Block& operator=(const Block&) = default;
+
+    ~Block() {
+        --alive;
+    }
+
+    int value;
+    char payload[60] = {};
+
+    static inline std::atomic<int> alive{0};
+    static inline int throw_on_copy_value = -1;
+};
+
+// Дескриптор ресурса: не является тривиально копируемым, но допускает побайтовый перенос
+struct Handle {
+    Handle() = default;
+
+    explicit Handle(int id)
+        : id(id) {
+    }
+
+    Handle(const Handle& other)
+        : id(other.id) {
+        ++num_copied;
+    }
+
+    Handle(Handle&& other) noexcept
+        : id(std::exchange(other.id, 0)) {
+        ++num_moved;
+    }
+
+    Handle& operator=(const Handle&) = default;
+    Handle& operator=(Handle&&) = default;
+
+    ~Handle() {
+        ++num_destroyed;
+    }
+
+    static void ResetCounters() {
+        num_copied = 0;
+        num_moved = 0;
+        num_destroyed = 0;
+    }
+
+    int id = 0;
+
+    static inline int num_copied = 0;
+    static inline int num_moved = 0;
+    static inline int num_destroyed = 0;
+};
+
+// Тип с конструктором перемещения без noexcept, как у многих старых классов и некоторых контейнеров
+struct LegacyMovable {
+    explicit LegacyMovable(int id)
+        : id(id) {
+    }
+
+    LegacyMovable(const LegacyMovable& other)
+        : id(other.id) {
+        ++num_copied;
+    }
+
+    LegacyMovable(LegacyMovable&& other) noexcept(false)
+        : id(std::exchange(other.id, -1)) {
+        if (throw_on_move_id >= 0 && id == throw_on_move_id) {
+            other.id = id;
+            throw std::runtime_error("LegacyMovable move exception");
+        }
+        ++num_moved;
+    }
+
+    LegacyMovable& operator=(const LegacyMovable&) = default;
+    LegacyMovable& operator=(LegacyMovable&&) = default;
+
+    static void ResetCounters() {
+        num_copied = 0;
+        num_moved = 0;
+        throw_on_move_id = -1;
+    }
+
+    int id;
+
+    static inline int num_copied = 0;
+    static inline int num_moved = 0;
+    static inline int throw_on_move_id = -1;
+};
+
 }  // namespace
 
+template <>
+struct is_trivially_relocatable<Handle> : std::true_type {
+};
+
 void Test1() {
     Obj::ResetCounters();
     const size_t SIZE = 100500;
@@ -563,84 +746,1645 @@ void Test6() {
 
 }
 
-struct C {
-    C() noexcept {
-        ++def_ctor;
+void Test7() {
+    const size_t SIZE = 10;
+    const int ID = 42;
+    AllocationCounters counters;
+    {
+        Obj::ResetCounters();
+        using Alloc = CountingAllocator<Obj>;
+        Vector<Obj, Alloc> v{Alloc{&counters}};
+        assert(counters.num_allocations == 0);
+        v.Reserve(SIZE);
+        assert(counters.num_allocations == 1);
+        assert(counters.allocated_items == SIZE);
+        for (size_t i = 0; i <= SIZE; ++i) {
+            v.EmplaceBack(ID);
+        }
+        assert(counters.num_allocations == 2);
+        assert(counters.num_deallocations == 1);
+        assert(v.Capacity() == SIZE * 2);
+
+        Vector<Obj, Alloc> v_copy(v);
+        assert(v_copy.GetAllocator() == v.GetAllocator());
+        assert(counters.num_allocations == 3);
+
+        Vector<Obj, Alloc> v_moved(std::move(v_copy));
+        assert(counters.num_allocations == 3);
+        assert(v_moved.Size() == SIZE + 1);
+        assert(v_moved[SIZE].id == ID);
+
+        v_moved.Insert(v_moved.cbegin() + 1, Obj{ID});
+        v.Resize(SIZE * 4);
+        assert(Obj::GetAliveObjectCount() == SIZE * 4 + SIZE + 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    assert(counters.num_allocations == counters.num_deallocations);
+    assert(counters.allocated_items == counters.deallocated_items);
+}
+
+void Test8() {
+    const size_t SIZE = 128;
+    {
+        Handle::ResetCounters();
+        Vector<Handle> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        assert(v.Size() == v.Capacity());
+        v.Insert(v.cbegin() + SIZE / 2, Handle{-1});
+        v.Reserve(SIZE * 4);
+        assert(v.Size() == SIZE + 1);
+        assert(v[SIZE / 2].id == -1);
+        assert(v[SIZE / 2 - 1].id == SIZE / 2 - 1);
+        assert(v[SIZE].id == SIZE - 1);
+        assert(Handle::num_copied == 0);
+        // Единственное перемещение и разрушение - временный объект, переданный в Insert
+        assert(Handle::num_moved == 1);
+        assert(Handle::num_destroyed == 1);
     }
-    C(const C& /*other*/) noexcept {
-        ++copy_ctor;
+    assert(Handle::num_destroyed == SIZE + 2);
+    {
+        Vector<int> v(1);
+        v[0] = 1;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.PushBack(v[0] + i);
+        }
+        v.Insert(v.cbegin(), v[SIZE]);
+        assert(v.Size() == SIZE + 2);
+        assert(v[0] == static_cast<int>(SIZE));
+        assert(v[SIZE + 1] == static_cast<int>(SIZE));
     }
-    C(C&& /*other*/) noexcept {
-        ++move_ctor;
+}
+
+void Test9() {
+    const int SIZE = 100'000;
+    {
+        // Порог отображения в одну страницу заставляет блоки переходить из кучи в mmap
+        Vector<int, MallocAllocator<int, 4096>> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack(i);
+        }
+        v.Insert(v.cbegin() + 1, v[SIZE - 1]);
+        v.Reserve(SIZE * 4);
+        assert(v.Size() == SIZE + 1);
+        assert(v.Capacity() == SIZE * 4);
+        assert(v[0] == 0);
+        assert(v[1] == SIZE - 1);
+        assert(v[SIZE] == SIZE - 1);
     }
-    C& operator=(const C& other) noexcept {
-        if (this != &other) {
-            ++copy_assign;
+    {
+        Handle::ResetCounters();
+        Vector<Handle, MallocAllocator<Handle>> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(i);
         }
-        return *this;
+        v.EmplaceBack(v[0]);
+        assert(v[SIZE].id == 0);
+        assert(v[SIZE - 1].id == SIZE - 1);
+        assert(Handle::num_copied == 1);
+        assert(Handle::num_moved == 0);
+        assert(Handle::num_destroyed == 0);
     }
-    C& operator=(C&& /*other*/) noexcept {
-        ++move_assign;
-        return *this;
+}
+
+void Test10() {
+    {
+        Vector<int, std::allocator<int>, FactorGrowth<>> v;
+        v.PushBack(1);
+        assert(v.Capacity() == 64 / sizeof(int));
+        v.Resize(v.Capacity());
+        v.PushBack(2);
+        assert(v.Capacity() == 64 / sizeof(int) * 3 / 2);
+        assert(v[v.Size() - 1] == 2);
+    }
+    {
+        Vector<Obj, std::allocator<Obj>, FactorGrowth<2, 1, 3>> v;
+        v.EmplaceBack(1);
+        assert(v.Capacity() == 3);
+        v.Resize(3);
+        v.EmplaceBack(2);
+        assert(v.Capacity() == 6);
+    }
+    {
+        Vector<int, std::allocator<int>, SizeClassGrowth<>> v;
+        v.PushBack(1);
+        assert(v.Capacity() == 16 / sizeof(int));
+        v.Resize(1000);
+        v.PushBack(2);
+        assert(v.Capacity() * sizeof(int) == 8192);
+    }
+    assert(DoublingGrowth<>::NextCapacity(std::numeric_limits<size_t>::max() / 2 + 1, 1, 1)
+           == std::numeric_limits<size_t>::max());
+    assert(FactorGrowth<>::NextCapacity(1, 2, 1) == 2);
+}
+
+void Test11() {
+    const size_t N = 4;
+    const int ID = 42;
+    AllocationCounters counters;
+    using Alloc = CountingAllocator<Obj>;
+    using SmallObjVector = SmallVector<Obj, N, Alloc>;
+    {
+        Obj::ResetCounters();
+        SmallObjVector v(N, Alloc{&counters});
+        assert(v.Capacity() == N);
+        v.Erase(v.cbegin());
+        v.Emplace(v.cbegin() + 1, ID);
+        v.Reserve(N);
+        assert(v.Size() == N);
+        assert(v[1].id == ID);
+        assert(counters.num_allocations == 0);
+
+        SmallObjVector v_copy(v);
+        SmallObjVector v_moved(std::move(v_copy));
+        assert(v_copy.Size() == 0);
+        assert(v_moved.Size() == N);
+        assert(v_moved[1].id == ID);
+        assert(counters.num_allocations == 0);
+
+        v.PushBack(Obj{ID + 1});
+        assert(counters.num_allocations == 1);
+        assert(v.Capacity() == N * 2);
+        assert(v[N].id == ID + 1);
+
+        const Obj* heap_data = &v[0];
+        SmallObjVector v_heap(std::move(v));
+        assert(&v_heap[0] == heap_data);
+        assert(v.Size() == 0 && v.Capacity() == N);
+
+        v_heap.Swap(v_moved);
+        assert(v_heap.Size() == N && v_moved.Size() == N + 1);
+        assert(&v_moved[0] == heap_data);
+        assert(v_heap[1].id == ID);
+
+        v_moved = std::move(v_heap);
+        assert(v_moved.Size() == N && v_moved.Capacity() == N);
+        assert(counters.num_deallocations == 1);
+
+        v_heap = v_moved;
+        v_heap.Resize(N * 4);
+        v_moved.Swap(v_heap);
+        assert(v_moved.Size() == N * 4 && v_heap.Size() == N);
+        assert(Obj::GetAliveObjectCount() == N * 5);
     }
-    ~C() {
-        ++dtor;
+    assert(Obj::GetAliveObjectCount() == 0);
+    assert(counters.num_allocations == counters.num_deallocations);
+    {
+        SmallVector<int, N> v;
+        for (int i = 0; i < 100; ++i) {
+            v.Insert(v.cbegin(), i);
+        }
+        assert(v.Size() == 100);
+        assert(v[0] == 99 && v[99] == 0);
     }
+}
+
+void Test12() {
+    const size_t SIZE = 10;
+    const int ID = 42;
+    AllocationCounters counters;
+    using Alloc = CountingAllocator<Obj>;
+    {
+        Obj::ResetCounters();
+        std::vector<Obj> source(SIZE * 10);
+        Vector<Obj, Alloc> v(source.begin(), source.end(), Alloc{&counters});
+        assert(v.Size() == SIZE * 10);
+        assert(counters.num_allocations == 1);
 
-    static void Reset() {
-        def_ctor = 0;
-        copy_ctor = 0;
-        move_ctor = 0;
-        copy_assign = 0;
-        move_assign = 0;
-        dtor = 0;
+        v.Append(source);
+        assert(v.Size() == SIZE * 20);
+        assert(counters.num_allocations == 2);
+        assert(Obj::num_copied == SIZE * 20);
     }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE * 3);
+        const std::vector<Obj> long_range(SIZE * 2, Obj{ID});
+        const std::vector<Obj> short_range(SIZE / 2, Obj{ID + 1});
+        Obj::ResetCounters();
 
-    inline static size_t def_ctor = 0;
-    inline static size_t copy_ctor = 0;
-    inline static size_t move_ctor = 0;
-    inline static size_t copy_assign = 0;
-    inline static size_t move_assign = 0;
-    inline static size_t dtor = 0;
-};
+        auto pos = v.Insert(v.cbegin() + 2, short_range.begin(), short_range.end());
+        assert(pos == v.begin() + 2);
+        assert(v.Size() == SIZE + SIZE / 2);
+        assert(v[2].id == ID + 1 && v[1].id == 0 && v[2 + SIZE / 2].id == 0);
+        assert(Obj::num_copied == 0);
+        assert(Obj::num_moved == SIZE / 2);
+        assert(Obj::num_move_assigned == SIZE - 2 - SIZE / 2);
+        assert(Obj::num_assigned == SIZE / 2);
+
+        v.Resize(SIZE);
+        Obj::ResetCounters();
+        pos = v.Insert(v.cbegin() + SIZE - 2, long_range.begin(), long_range.end());
+        assert(v.Size() == SIZE * 3);
+        assert(v[SIZE - 3].id == 0 && v[SIZE - 2].id == ID && v[SIZE * 3 - 1].id == 0);
+        assert(Obj::num_copied == SIZE * 2 - 2);
+        assert(Obj::num_moved == 2);
+        assert(Obj::num_assigned == 2);
+        assert(v.Capacity() == SIZE * 3);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v[0].id = ID;
+        v.Insert(v.cbegin(), SIZE * 5, v[0]);
+        assert(v.Size() == SIZE * 6);
+        assert(v.Capacity() == SIZE * 6);
+        assert(v[SIZE * 5 - 1].id == ID && v[SIZE * 5].id == ID && v[SIZE * 5 + 1].id == 0);
+        assert(Obj::num_moved == SIZE);
+        assert(Obj::GetAliveObjectCount() == SIZE * 6);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        std::vector<Obj> source(SIZE * 2);
+        source[SIZE].throw_on_copy = true;
+        try {
+            v.Insert(v.cbegin() + 1, source.begin(), source.end());
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == SIZE && v.Capacity() == SIZE);
+        assert(Obj::GetAliveObjectCount() == SIZE * 3);
+    }
+    {
+        std::istringstream input("1 2 3 4 5");
+        Vector<int> v(2);
+        auto pos = v.Insert(v.cbegin() + 1, std::istream_iterator<int>(input), std::istream_iterator<int>());
+        assert(pos == v.begin() + 1);
+        assert(v.Size() == 7);
+        assert(v[0] == 0 && v[1] == 1 && v[5] == 5 && v[6] == 0);
 
-void Dump() {
-    using namespace std;
-    cerr << "Def ctors: "sv << C::def_ctor              //
-         << ", Copy ctors: "sv << C::copy_ctor          //
-         << ", Move ctors: "sv << C::move_ctor          //
-         << ", Copy assignments: "sv << C::copy_assign  //
-         << ", Move assignments: "sv << C::move_assign  //
-         << ", Dtors: "sv << C::dtor << endl;
+        v.Insert(v.cbegin() + 3, 3, 7);
+        assert(v.Size() == 10);
+        assert(v[2] == 2 && v[3] == 7 && v[5] == 7 && v[6] == 3);
+        const int values[] = {8, 9};
+        v.Append(values);
+        assert(v.Size() == 12 && v[11] == 9);
+    }
 }
 
-void Benchmark() {
-    using namespace std;
-    try {
-        const size_t NUM = 10;
-        C c;
-        {
-            cerr << "std::vector:"sv << endl;
-            C::Reset();
-            vector<C> v(NUM);
-            Dump();
-            v.push_back(c);
+void Test13() {
+    const size_t SIZE = 10;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].id = static_cast<int>(i);
+        }
+        auto pos = v.Erase(v.cbegin() + 2, v.cbegin() + 5);
+        assert(pos == v.begin() + 2);
+        assert(v.Size() == SIZE - 3);
+        assert(v.Capacity() == SIZE);
+        assert(v[1].id == 1 && v[2].id == 5 && v[SIZE - 4].id == SIZE - 1);
+        assert(Obj::num_move_assigned == SIZE - 5);
+        assert(Obj::num_destroyed == 3);
+
+        pos = v.Erase(v.cbegin() + 1, v.cbegin() + 1);
+        assert(pos == v.begin() + 1);
+        assert(v.Size() == SIZE - 3);
+
+        Obj::ResetCounters();
+        pos = v.SwapErase(v.cbegin());
+        assert(pos == v.begin());
+        assert(v[0].id == SIZE - 1);
+        assert(v.Size() == SIZE - 4);
+        assert(Obj::num_move_assigned == 1);
+        v.SwapErase(v.cend() - 1);
+        assert(v.Size() == SIZE - 5);
+        assert(Obj::num_move_assigned == 1);
+
+        const size_t erased = v.EraseIf([](const Obj& obj) {
+            return obj.id % 2 == 0;
+        });
+        assert(erased == 1);
+        assert(v.Size() == SIZE - 6);
+        assert(v[0].id == SIZE - 1 && v[1].id == 1 && v[2].id == 5 && v[3].id == 7);
+        assert(Obj::num_destroyed == 2 + static_cast<int>(erased));
+    }
+    {
+        Vector<int> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.PushBack(i);
         }
-        Dump();
-    } catch (...) {
+        v.Erase(v.cbegin(), v.cbegin() + 3);
+        assert(v.Size() == SIZE - 3 && v[0] == 3 && v[SIZE - 4] == SIZE - 1);
+        v.Erase(v.cbegin(), v.cend());
+        assert(v.Size() == 0);
     }
-    try {
-        const size_t NUM = 10;
-        C c;
-        {
-            cerr << "Vector:"sv << endl;
-            C::Reset();
-            Vector<C> v(NUM);
-            Dump();
-            v.PushBack(c);
+}
+
+void Test14() {
+    const size_t SIZE = 100;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE, default_init);
+        v.ResizeDefaultInit(SIZE * 2);
+        assert(v.Size() == SIZE * 2);
+        assert(Obj::num_default_constructed == SIZE * 2);
+    }
+    {
+        Vector<int> v(SIZE, default_init);
+        assert(v.Size() == SIZE && v.Capacity() == SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i] = static_cast<int>(i);
+        }
+        v.ResizeDefaultInit(SIZE / 2);
+        assert(v.Size() == SIZE / 2 && v[SIZE / 2 - 1] == SIZE / 2 - 1);
+
+        v.ResizeAndOverwrite(SIZE * 2, [](int* data, size_t count) {
+            assert(data[0] == 0 && data[SIZE / 2 - 1] == SIZE / 2 - 1);
+            const size_t filled = count - 10;
+            for (size_t i = SIZE / 2; i < filled; ++i) {
+                data[i] = -1;
+            }
+            return filled;
+        });
+        assert(v.Size() == SIZE * 2 - 10);
+        assert(v.Capacity() == SIZE * 2);
+        assert(v[SIZE / 2 - 1] == SIZE / 2 - 1 && v[SIZE / 2] == -1 && v[SIZE * 2 - 11] == -1);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        try {
+            v.ResizeAndOverwrite(SIZE * 2, [](Obj*, size_t) -> size_t {
+                throw std::runtime_error("Oops");
+            });
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == SIZE);
+        v.ResizeAndOverwrite(SIZE / 2, [](Obj* data, size_t count) {
+            data[0].id = 1;
+            return count;
+        });
+        assert(v.Size() == SIZE / 2 && v[0].id == 1);
+        assert(Obj::GetAliveObjectCount() == SIZE / 2);
+    }
+}
+
+void Test15() {
+    const size_t SIZE = 100;
+    AllocationCounters counters;
+    {
+        Obj::ResetCounters();
+        using Alloc = CountingAllocator<Obj>;
+        Vector<Obj, Alloc> v(SIZE, Alloc{&counters});
+        v.Resize(SIZE / 2);
+        v[0].id = 1;
+        v.ShrinkToFit();
+        assert(v.Size() == SIZE / 2 && v.Capacity() == SIZE / 2);
+        assert(v[0].id == 1);
+        assert(Obj::num_moved == SIZE / 2);
+        assert(Obj::num_copied == 0);
+        assert(counters.num_allocations == 2 && counters.num_deallocations == 1);
+
+        v.ShrinkTo(SIZE);
+        v.ShrinkTo(0);
+        assert(v.Capacity() == SIZE / 2);
+        v.Clear();
+        assert(v.Size() == 0 && v.Capacity() == SIZE / 2);
+        assert(Obj::GetAliveObjectCount() == 0);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+        assert(counters.num_allocations == counters.num_deallocations);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v[SIZE - 1].throw_on_copy = true;
+        v.Reserve(SIZE * 2);
+        v.ShrinkTo(SIZE + 1);
+        assert(v.Capacity() == SIZE + 1);
+        assert(Obj::num_copied == 0);
+    }
+    {
+        SmallVector<std::string, 4> v;
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(std::to_string(i));
+        }
+        v.Resize(3);
+        v.ShrinkTo(6);
+        assert(v.Capacity() == 6);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 4);
+        assert(v[0] == "0" && v[2] == "2");
+    }
+    {
+        Vector<int, MallocAllocator<int>> v(SIZE);
+        v[SIZE / 2] = 1;
+        v.Resize(SIZE / 2 + 1);
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE / 2 + 1 && v[SIZE / 2] == 1);
+        v.Clear();
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+    }
+}
+
+void Test16() {
+    struct StatsTag {};
+    using Stats = VectorStats<StatsTag>;
+    Stats::Reset();
+    {
+        Vector<int, std::allocator<int>, DoublingGrowth<>, RawMemory<int>, Stats> v;
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack(i);
+        }
+        // Вместимости 1, 2, 4, 8
+        assert(Stats::Allocations() == 4);
+        assert(Stats::BytesAllocated() == (1 + 2 + 4 + 8) * sizeof(int));
+        assert(Stats::Reallocations(ReallocationReason::Emplace) == 4);
+        assert(Stats::Relocated(RelocationKind::Bitwise) == 1 + 2 + 4);
+        v.Reserve(100);
+        assert(Stats::Reallocations(ReallocationReason::Reserve) == 1);
+        v.ShrinkToFit();
+        assert(Stats::Reallocations(ReallocationReason::Shrink) == 1);
+        assert(Stats::PeakCapacity() == 100);
+        const int values[] = {1, 2, 3, 4, 5, 6};
+        v.Insert(v.cbegin(), std::begin(values), std::end(values));
+        assert(Stats::Reallocations(ReallocationReason::Insert) == 1);
+        auto copy = v;
+        assert(Stats::Allocations() == 8);
+    }
+    struct MayThrowOnMove {
+        MayThrowOnMove() = default;
+        MayThrowOnMove(const MayThrowOnMove&) = default;
+        MayThrowOnMove(MayThrowOnMove&&) noexcept(false) {
+        }
+    };
+    Stats::Reset();
+    {
+        Vector<std::string, std::allocator<std::string>, DoublingGrowth<>, RawMemory<std::string>, Stats> strings(2);
+        strings.Reserve(4);
+        assert(Stats::Relocated(RelocationKind::Move) == 2);
+        Vector<MayThrowOnMove, std::allocator<MayThrowOnMove>, DoublingGrowth<>, RawMemory<MayThrowOnMove>, Stats> v(3);
+        v.Reserve(4);
+        assert(Stats::Relocated(RelocationKind::Copy) == 3);
+        assert(Stats::Relocated(RelocationKind::Bitwise) == 0);
+    }
+    Stats::Reset();
+    {
+        SmallVector<int, 4, std::allocator<int>, DoublingGrowth<>, Stats> v;
+        for (int i = 0; i < 4; ++i) {
+            v.PushBack(i);
+        }
+        assert(Stats::Allocations() == 0);
+        v.PushBack(4);
+        assert(Stats::Allocations() == 1 && Stats::Relocated(RelocationKind::Bitwise) == 4);
+    }
+}
+
+void Test17() {
+    // Не менее мегабайта на поток: вектор из SIZE элементов делится на 4 части
+    const size_t SIZE = 80'000;
+    const ParallelTag four_threads(4);
+    {
+        Vector<int> v(SIZE * 16, four_threads);
+        assert(v.Size() == SIZE * 16);
+        assert(std::all_of(v.begin(), v.end(), [](int x) {
+            return x == 0;
+        }));
+        for (size_t i = 0; i < v.Size(); ++i) {
+            v[i] = static_cast<int>(i);
+        }
+        Vector<int> copy(v, four_threads);
+        assert(std::equal(v.begin(), v.end(), copy.begin(), copy.end()));
+        copy.Reserve(copy.Size() * 2, four_threads);
+        assert(std::equal(v.begin(), v.end(), copy.begin(), copy.end()));
+        copy.Resize(copy.Size() + 10, four_threads);
+        assert(copy[v.Size()] == 0 && copy[v.Size() - 1] == v[v.Size() - 1]);
+    }
+    {
+        Vector<Block> v(SIZE, four_threads);
+        assert(Block::alive == static_cast<int>(SIZE));
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].value = static_cast<int>(i);
+        }
+        v.Reserve(SIZE * 2, four_threads);
+        assert(Block::alive == static_cast<int>(SIZE) && v.Capacity() == SIZE * 2);
+        assert(v[SIZE - 1].value == static_cast<int>(SIZE - 1));
+        v.Resize(SIZE * 3, four_threads);
+        assert(Block::alive == static_cast<int>(SIZE * 3) && v[SIZE * 2].value == 0);
+
+        // Исключение в части, обрабатываемой другим потоком, разрушает все созданные элементы
+        v.Resize(SIZE);
+        Block::throw_on_copy_value = static_cast<int>(SIZE - 10);
+        try {
+            Vector<Block> copy(v, four_threads);
+            assert(false);
+        } catch (const std::runtime_error&) {
         }
-        Dump();
-    } catch (...) {
+        assert(Block::alive == static_cast<int>(SIZE));
+        Block::throw_on_copy_value = -1;
+        Vector<Block> copy(v, four_threads);
+        assert(Block::alive == static_cast<int>(SIZE * 2));
+        assert(copy[SIZE - 10].value == static_cast<int>(SIZE - 10));
+    }
+    assert(Block::alive == 0);
+    {
+        // Небольшие векторы обрабатываются в текущем потоке
+        Vector<std::string> v(3, parallel);
+        v[0] = "a";
+        v.Reserve(10, parallel);
+        assert(v.Size() == 3 && v.Capacity() == 10 && v[0] == "a");
+    }
+}
+
+void Test18() {
+    const size_t SIZE = (size_t{4} << 20) / sizeof(int);
+    for (HugePageMode mode : {HugePageMode::None, HugePageMode::Transparent, HugePageMode::Explicit2MB}) {
+        MemoryPlacement placement;
+        placement.huge_pages = mode;
+        placement.numa = NumaMode::Bind;
+        placement.numa_nodes = 1;
+        using Alloc = HugePageAllocator<int>;
+        Vector<int, Alloc> v{Alloc(placement)};
+        // Буфер растёт от malloc через порог mmap_threshold
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        assert(v.GetAllocator().GetPlacement() == placement);
+        v.Reserve(SIZE * 3);
+        for (size_t i = 0; i < SIZE; ++i) {
+            assert(v[i] == static_cast<int>(i));
+        }
+        Vector<int, Alloc> copy(v);
+        assert(copy.GetAllocator() == v.GetAllocator());
+        copy.ShrinkTo(10);
+        assert(copy.Capacity() == SIZE && copy[SIZE - 1] == static_cast<int>(SIZE - 1));
+    }
+    {
+        MemoryPlacement placement;
+        placement.numa = NumaMode::Interleave;
+        placement.numa_nodes = ~0ul;
+        placement.mmap_threshold = 0;
+        Vector<std::string, HugePageAllocator<std::string>> v{HugePageAllocator<std::string>(placement)};
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(std::to_string(i));
+        }
+        assert(v[99] == "99");
+    }
+}
+
+void Test19() {
+    const auto is_aligned = [](const void* p, size_t alignment) {
+        return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+    };
+    {
+        AlignedVector<float> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(static_cast<float>(i));
+            assert(is_aligned(&v[0], kCacheLineSize));
+        }
+        AlignedVector<float> copy(v);
+        assert(is_aligned(&copy[0], kCacheLineSize) && copy[99] == 99.0f);
+    }
+    {
+        AlignedVector<std::string, 4096> v(3);
+        v[2] = "aligned";
+        v.Reserve(1000);
+        assert(is_aligned(&v[0], 4096) && v[2] == "aligned");
+    }
+    {
+        // Типы с повышенным выравниванием получают его и от std::allocator
+        struct alignas(128) Wide {
+            int value = 0;
+        };
+        Vector<Wide> v(5);
+        v.PushBack(Wide{7});
+        assert(is_aligned(&v[0], 128) && v[5].value == 7);
+    }
+}
+
+void Test20() {
+    {
+        SoaVector<int, std::string, double> v;
+        for (int i = 0; i < 10; ++i) {
+            v.EmplaceBack(i, std::to_string(i), i * 0.5);
+        }
+        assert(v.Size() == 10 && v.Capacity() == 16);
+        const Span<int> ids = v.Column<0>();
+        assert(ids.Size() == 10 && ids[9] == 9);
+        double sum = 0;
+        for (double x : v.Column<2>()) {
+            sum += x;
+        }
+        assert(sum == 22.5);
+
+        // Аргумент, ссылающийся на элемент вектора, переживает перевыделение памяти
+        v.Reserve(10);
+        v.EmplaceBack(v.Get<0>(0), v.Get<1>(9), 0.0);
+        assert(v.Get<1>(10) == "9");
+
+        v.Erase(2, 5);
+        assert(v.Size() == 8 && v.Get<0>(2) == 5 && v.Get<1>(2) == "5");
+        v.Erase(0);
+        v.PopBack();
+        assert(v.Size() == 6 && v.Get<1>(0) == "1" && v.Get<1>(5) == "9");
+
+        const SoaVector<int, std::string, double> copy(v);
+        const Span<const std::string> names = copy.Column<1>();
+        assert(std::equal(names.begin(), names.end(), v.Column<1>().begin()));
+        SoaVector<int, std::string, double> moved(std::move(v));
+        assert(moved.Size() == 6 && v.Size() == 0);
+        v = copy;
+        assert(v.Size() == 6 && v.Get<0>(5) == 9);
+    }
+    {
+        // Столбцы, копируемые при переносе, обеспечивают строгую гарантию
+        Obj::ResetCounters();
+        {
+            SoaVector<Obj, Block> v(4);
+            assert(v.Capacity() == 4);
+            v.Get<1>(3).value = 42;
+            Block::throw_on_copy_value = 42;
+            try {
+                v.EmplaceBack(1, 1);
+                assert(false);
+            } catch (const std::runtime_error&) {
+            }
+            Block::throw_on_copy_value = -1;
+            assert(v.Size() == 4 && v.Capacity() == 4);
+            assert(Obj::num_moved == 0 && Obj::GetAliveObjectCount() == 4 && Block::alive == 4);
+            v.EmplaceBack(1, 1);
+            assert(Obj::num_moved == 4 && Obj::GetAliveObjectCount() == 5 && Block::alive == 5);
+            assert(v.Get<1>(3).value == 42 && v.Get<0>(4).id == 1);
+        }
+        assert(Obj::GetAliveObjectCount() == 0 && Block::alive == 0);
+    }
+}
+
+void Test21() {
+    {
+        SegmentedVector<int, std::allocator<int>, 4> v;
+        v.PushBack(0);
+        const int* first = &v[0];
+        for (int i = 1; i < 1000; ++i) {
+            v.PushBack(i);
+        }
+        // Сегменты по 4, 8, 16, ... элементов
+        assert(v.Size() == 1000 && v.Capacity() == 1020);
+        assert(first == &v[0]);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(v[i] == static_cast<int>(i));
+        }
+        assert(std::is_sorted(v.begin(), v.end()));
+        assert(v.end() - v.begin() == 1000 && *(v.cbegin() + 500) == 500);
+
+        v.EmplaceBack(v[999]);
+        assert(v[1000] == 999);
+        while (v.Size() > 10) {
+            v.PopBack();
+        }
+        v.ShrinkToFit();
+        assert(v.Capacity() == 12 && first == &v[0]);
+        v.Reserve(100);
+        assert(v.Capacity() == 124 && first == &v[0]);
+    }
+    {
+        Obj::ResetCounters();
+        {
+            SegmentedVector<Obj> v;
+            for (int i = 0; i < 100; ++i) {
+                v.EmplaceBack(i, std::to_string(i));
+            }
+            assert(Obj::num_moved == 0 && Obj::num_copied == 0);
+            SegmentedVector<Obj> copy(v);
+            assert(Obj::num_copied == 100 && copy[99].id == 99);
+            SegmentedVector<Obj> moved(std::move(copy));
+            assert(copy.Size() == 0 && moved.Size() == 100);
+            copy = v;
+            v.Clear();
+            assert(v.Size() == 0 && copy.Size() == 100);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void Test22() {
+    const int THREADS = 8;
+    const int PER_THREAD = 10'000;
+    ConcurrentVector<std::string> v;
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        // Все опубликованные элементы сконструированы
+        while (!done) {
+            const size_t size = v.Size();
+            for (size_t i = 0; i < size; i += 97) {
+                assert(!v[i].empty());
+            }
+        }
+    });
+    std::vector<std::thread> producers;
+    for (int t = 0; t < THREADS; ++t) {
+        producers.emplace_back([&v, t] {
+            // Адрес первого элемента потока остаётся действительным, пока последующие добавления
+            // пересекают границы сегментов
+            const std::string expected = std::to_string(t * PER_THREAD);
+            const size_t index = v.PushBack(std::string(expected));
+            const std::string* address = &v[index];
+            assert(*address == expected);
+            for (int i = 1; i < PER_THREAD; ++i) {
+                std::string value = std::to_string(t * PER_THREAD + i);
+                const std::string copy = value;
+                assert(v[v.PushBack(std::move(value))] == copy);
+            }
+            assert(&v[index] == address && *address == expected);
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    done = true;
+    reader.join();
+
+    assert(v.Size() == static_cast<size_t>(THREADS * PER_THREAD));
+    std::vector<bool> seen(THREADS * PER_THREAD);
+    for (size_t i = 0; i < v.Size(); ++i) {
+        const int value = std::stoi(v[i]);
+        assert(!seen[value]);
+        seen[value] = true;
+    }
+
+    ConcurrentVector<int> ints;
+    ints.Reserve(1000);
+    for (int i = 0; i < 1000; ++i) {
+        assert(ints.EmplaceBack(i) == static_cast<size_t>(i));
+    }
+    const int* first = &ints[0];
+    ints.PushBack(1000);
+    assert(first == &ints[0] && ints[1000] == 1000 && ints.Size() == 1001);
+
+    // Элементы, признаки готовности и заголовки сегментов выделяются через аллокатор
+    AllocationCounters counters;
+    {
+        ConcurrentVector<int, CountingAllocator<int>> counted{CountingAllocator<int>(&counters)};
+        for (int i = 0; i < 100; ++i) {
+            counted.PushBack(i);
+        }
+        assert(counted.Size() == 100 && counters.num_allocations == 2 * 3);
+    }
+    assert(counters.num_deallocations == counters.num_allocations);
+}
+
+void Test23() {
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        v.Reserve(10);
+        for (int i = 0; i < 5; ++i) {
+            v.EmplaceBack(i);
+        }
+        Obj::ResetCounters();
+        v.Insert(v.cbegin() + 1, Obj(10));
+        // Временный объект не создаётся: хвост сдвигается, а аргумент присваивается на место
+        assert(Obj::num_moved == 1 && Obj::num_move_assigned == 4);
+        assert(v[0].id == 0 && v[1].id == 10 && v[2].id == 1 && v[5].id == 4);
+        v.Insert(v.cbegin(), v[3]);
+        assert(v[0].id == 2 && v[4].id == 2 && Obj::num_copied == 0 && Obj::num_assigned == 1);
+        v.Insert(v.cbegin() + 1, std::move(v[6]));
+        assert(v[1].id == 4 && v.Size() == 8);
+    }
+    {
+        Vector<std::string> v;
+        v.Reserve(8);
+        for (const char* s : {"a", "c", "d"}) {
+            v.PushBack(s);
+        }
+        v.Insert(v.cbegin() + 1, std::string("b"));
+        v.Insert(v.cbegin(), v[3]);
+        const std::vector<std::string> expected{"d", "a", "b", "c", "d"};
+        assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+    }
+    {
+        Handle::ResetCounters();
+        Vector<Handle> v;
+        v.Reserve(10);
+        for (int i = 1; i <= 5; ++i) {
+            v.EmplaceBack(i);
+        }
+        Handle::ResetCounters();
+        // Хвост сдвигается memmove, а элемент конструируется прямо в освободившейся ячейке
+        v.Insert(v.cbegin() + 2, Handle(10));
+        assert(Handle::num_moved == 1 && Handle::num_copied == 0);
+        v.Insert(v.cbegin(), v[4]);
+        assert(Handle::num_copied == 1 && v[0].id == 4 && v[5].id == 4);
+        v.Emplace(v.cbegin() + 1, 20);
+        assert(Handle::num_moved == 1 && Handle::num_copied == 1);
+        const int expected[] = {4, 20, 1, 2, 10, 3, 4, 5};
+        assert(v.Size() == 8);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(v[i].id == expected[i]);
+        }
+    }
+}
+
+void Test24() {
+    {
+        Vector<double> source(100);
+        for (size_t i = 0; i < source.Size(); ++i) {
+            source[i] = static_cast<double>(i) / 4;
+        }
+        Vector<double> snapshot(source);
+        assert(snapshot.Size() == 100 && snapshot[99] == 99.0 / 4);
+        // Присваивание в пределах вместимости: часть элементов перезаписывается, часть создаётся
+        Vector<double> small(10);
+        small.Reserve(200);
+        small = source;
+        assert(small.Capacity() == 200 && std::equal(small.begin(), small.end(), source.begin(), source.end()));
+        source.Resize(5);
+        small = source;
+        assert(small.Size() == 5 && small[4] == 1.0);
+        small = Vector<double>();
+        assert(small.Size() == 0);
+        const Vector<double> empty;
+        Vector<double> copy(empty);
+        assert(copy.Size() == 0);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> source(5);
+        Vector<Obj> destination(3);
+        destination.Reserve(10);
+        destination = source;
+        assert(Obj::num_assigned == 3 && Obj::num_copied == 2);
+        destination = Vector<Obj>(1);
+        assert(destination.Size() == 1 && Obj::GetAliveObjectCount() == 6);
+    }
+}
+
+void Test25() {
+    using Checked = Vector<int, std::allocator<int>, DoublingGrowth<>, RawMemory<int>, NoVectorStats, ThrowingAccess>;
+    using Unchecked = Vector<int, std::allocator<int>, DoublingGrowth<>, RawMemory<int>, NoVectorStats, UncheckedAccess>;
+    static_assert(!noexcept(std::declval<Checked&>()[0]));
+    static_assert(noexcept(std::declval<Unchecked&>()[0]) && noexcept(std::declval<Vector<int>&>()[0]));
+    {
+        Checked v(3);
+        v[2] = 5;
+        try {
+            v[3] = 1;
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+        const Checked& cv = v;
+        assert(cv[2] == 5);
+    }
+    {
+        Unchecked v(4);
+        int* data = v.Data();
+        for (size_t i = 0; i < v.Size(); ++i) {
+            data[i] = static_cast<int>(i);
+        }
+        assert(v.At(3) == 3);
+        try {
+            v.At(4);
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+        const Unchecked& cv = v;
+        const Span<const int> span = cv.AsSpan();
+        assert(span.Size() == 4 && span.Data() == cv.Data() && span[3] == 3);
+        v.AsSpan()[0] = 10;
+        assert(v[0] == 10 && span.Subspan(1, 2)[1] == 2);
+    }
+    {
+        SmallVector<std::string, 2, std::allocator<std::string>, DoublingGrowth<>, NoVectorStats, ThrowingAccess> v;
+        v.PushBack("a");
+        const auto& cv = v;
+        assert(cv.Data() == &cv[0] && cv.At(0) == "a");
+        try {
+            v[1];
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+    }
+}
+
+void Test26() {
+    struct Record {
+        int id;
+        double value;
+    };
+    const std::string path = "/tmp/advanced_vector_test_" + std::to_string(::getpid()) + ".bin";
+    std::remove(path.c_str());
+    const size_t SIZE = 10'000;
+    {
+        MappedVector<Record> v(path);
+        assert(v.Size() == 0 && v.Capacity() == 0);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(Record{static_cast<int>(i), i * 0.5});
+        }
+        v.EmplaceBack(v[0]);
+        assert(v.Size() == SIZE + 1 && v.Capacity() >= SIZE + 1 && v[SIZE].id == 0);
+        v.PopBack();
+        v.Flush();
+    }
+    {
+        // Повторное открытие не требует чтения элементов
+        MappedVector<Record> v(path);
+        assert(v.Size() == SIZE && v[SIZE - 1].id == static_cast<int>(SIZE - 1) && v[SIZE - 1].value == (SIZE - 1) * 0.5);
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE);
+        v.Resize(SIZE + 5);
+        assert(v[SIZE + 4].id == 0 && v.AsSpan().Size() == SIZE + 5);
+        MappedVector<Record> moved(std::move(v));
+        assert(v.Size() == 0 && v.Capacity() == 0 && v.begin() == v.end() && v.AsSpan().Size() == 0);
+        moved.Resize(3);
+        moved.ShrinkToFit();
+        assert(moved.Capacity() == 3);
+        moved.Reserve(100);
+        assert(moved.Capacity() == 100 && moved.end() - moved.begin() == 3);
+
+        // Файл или отображение такой длины создать нельзя: вектор и файл остаются прежними
+        try {
+            moved.Reserve((size_t{1} << 60) / sizeof(Record));
+            assert(false);
+        } catch (const std::system_error&) {
+        }
+        struct stat info {};
+        assert(::stat(path.c_str(), &info) == 0);
+        assert(static_cast<size_t>(info.st_size) == kMappedHeaderSize + 100 * sizeof(Record));
+        assert(moved.Capacity() == 100 && moved.Size() == 3 && moved[2].id == 2);
+        moved.Resize(100);
+        moved[99].id = 99;
+        moved.Resize(3);
+        v = std::move(moved);
+        assert(moved.Size() == 0 && moved.Capacity() == 0 && moved.Data() == nullptr);
+        assert(v.Size() == 3 && v.Capacity() == 100 && v[2].id == 2);
+    }
+    {
+        MappedVector<Record> v(path);
+        assert(v.Size() == 3 && v[2].id == 2);
+        try {
+            MappedVector<int> wrong(path);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+    }
+    std::remove(path.c_str());
+}
+
+void Test27() {
+    {
+        // Больше одного блока чтения
+        const size_t SIZE = 1'000'000;
+        Vector<int> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i] = static_cast<int>(i * 7);
+        }
+        std::stringstream stream;
+        Serialize(stream, v);
+        assert(stream.str().size() == 16 + SIZE * sizeof(int));
+        Vector<int> restored(3);
+        Deserialize(stream, restored);
+        assert(restored.Size() == SIZE && restored.Capacity() == SIZE);
+        assert(std::equal(v.begin(), v.end(), restored.begin(), restored.end()));
+    }
+    {
+        Vector<Vector<std::string>> v;
+        v.EmplaceBack();
+        v[0].PushBack("first");
+        v[0].PushBack(std::string(5000, 'x'));
+        v.EmplaceBack(size_t{3});
+        std::stringstream stream;
+        Serialize(stream, v);
+        Vector<Vector<std::string>> restored;
+        Deserialize(stream, restored);
+        assert(restored.Size() == 2 && restored[0].Size() == 2 && restored[1].Size() == 3);
+        assert(restored[0][0] == "first" && restored[0][1] == v[0][1] && restored[1][2].empty());
+    }
+    {
+        Vector<std::string> v;
+        v.PushBack("keep");
+        Vector<double> doubles(10);
+        std::stringstream stream;
+        Serialize(stream, doubles);
+        // Неподходящая раскладка элементов
+        try {
+            Deserialize(stream, v);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 1 && v[0] == "keep");
+
+        // Оборванный поток не меняет вектор
+        std::string data;
+        {
+            std::stringstream full;
+            Serialize(full, doubles);
+            data = full.str();
+        }
+        std::stringstream truncated(data.substr(0, data.size() - 4));
+        Vector<double> target(2);
+        try {
+            Deserialize(truncated, target);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(target.Size() == 2);
+
+        // Повреждённый размер в заголовке не приводит к выделению памяти под весь вектор
+        std::string corrupted = data;
+        const uint64_t huge_size = uint64_t{1} << 50;
+        std::memcpy(corrupted.data() + offsetof(detail::SerializedVectorHeader, size), &huge_size, sizeof(huge_size));
+        std::stringstream corrupted_stream(corrupted);
+        try {
+            Deserialize(corrupted_stream, target);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(target.Size() == 2);
+
+        // Длину потока без позиционирования проверить нельзя: резервируется ограниченный объём
+        struct UnseekableBuffer : std::stringbuf {
+            using std::stringbuf::stringbuf;
+
+            pos_type seekoff(off_type, std::ios_base::seekdir, std::ios_base::openmode) override {
+                return pos_type(off_type(-1));
+            }
+
+            pos_type seekpos(pos_type, std::ios_base::openmode) override {
+                return pos_type(off_type(-1));
+            }
+        };
+        UnseekableBuffer corrupted_buffer(corrupted);
+        std::istream unseekable(&corrupted_buffer);
+        try {
+            Deserialize(unseekable, target);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        UnseekableBuffer buffer(data);
+        std::istream valid(&buffer);
+        Deserialize(valid, target);
+        assert(target.Size() == 10 && target.Capacity() == 10 && target[9] == 0.0);
+    }
+}
+
+template <typename T>
+void TestAlgorithmsFor() {
+    // Размеры вокруг ширины векторов, чтобы проверить и основной цикл, и хвост
+    for (size_t size : {1, 7, 16, 63, 64, 65, 1000, 100'000}) {
+        Vector<T> v(size);
+        Fill(v, T(3));
+        assert(Count(v, T(3)) == size && Find(v, T(1)) == size);
+        for (size_t i = 0; i < size; ++i) {
+            v[i] = static_cast<T>(i % 100);
+        }
+        v[size - 1] = T(101);
+        detail::SumType<T> expected_sum = 0;
+        size_t expected_count = 0;
+        for (size_t i = 0; i < size; ++i) {
+            expected_sum += v[i];
+            expected_count += v[i] == T(42);
+        }
+        assert(Sum(v) == expected_sum);
+        assert(Count(v, T(42)) == expected_count);
+        assert(Find(v, T(101)) == size - 1);
+        assert(Find(v, T(0)) == (size == 1 ? size : 0));
+        const auto [min, max] = MinMax(v);
+        assert(min == (size == 1 ? T(101) : T(0)) && max == T(101));
+
+        Vector<T> copy(v);
+        assert(Equal(v, copy) && v == copy);
+        copy[size / 2] = T(102);
+        assert(!Equal(v, copy) && v != copy);
+        TransformInPlace(copy, [](auto x) {
+            return x * 2;
+        });
+        assert(copy[size / 2] == T(204) && (size == 1 || copy[size - 1] == static_cast<T>(202)));
+    }
+}
+
+void Test28() {
+    TestAlgorithmsFor<int>();
+    TestAlgorithmsFor<float>();
+    TestAlgorithmsFor<double>();
+    TestAlgorithmsFor<uint8_t>();
+    TestAlgorithmsFor<int64_t>();
+    {
+        Vector<double> v(3);
+        v[1] = -1.5;
+        v[2] = std::numeric_limits<double>::quiet_NaN();
+        assert(MinMax(v) == std::make_pair(-1.5, 0.0));
+        assert(!Equal(v, v));
+        Vector<double> zeros(2);
+        Vector<double> negative_zeros(2);
+        Fill(negative_zeros, -0.0);
+        assert(Equal(zeros, negative_zeros));
+        const Span<const double> tail = v.AsSpan().Subspan(1, 2);
+        assert(Find(tail, -1.5) == 0 && Sum(zeros.AsSpan()) == 0.0);
+    }
+    const Vector<std::string> a(2);
+    Vector<std::string> b(2);
+    assert(a == b);
+    b[1] = "x";
+    assert(a != b);
+}
+
+void Test29() {
+    {
+        FlatSet<int> set{5, 1, 3, 1};
+        assert(set.Size() == 3 && std::is_sorted(set.begin(), set.end()));
+        assert(set.Insert(2).second && !set.Insert(3).second);
+        assert(*set.Find(2) == 2 && set.Find(4) == set.end() && !set.Contains(4));
+        assert(*set.LowerBound(4) == 5 && *set.UpperBound(2) == 3);
+
+        // Пакетная вставка сливает неупорядоченный диапазон с повторами за один проход
+        const std::vector<int> batch{9, 0, 4, 5, 9, 7};
+        set.Insert(batch.begin(), batch.end());
+        const std::vector<int> expected{0, 1, 2, 3, 4, 5, 7, 9};
+        assert(std::equal(set.begin(), set.end(), expected.begin(), expected.end()));
+
+        assert(set.Erase(4) == 1 && set.Erase(4) == 0);
+        assert(set.EraseIf([](int key) {
+                   return key % 2 != 0;
+               }) == 5);
+        assert(set == (FlatSet<int>{0, 2}));
+        const Vector<int> keys = set.Extract();
+        assert(keys.Size() == 2 && set.Empty());
+    }
+    {
+        // Прозрачный компаратор позволяет искать строки по std::string_view без временных копий
+        FlatSet<std::string, std::less<>> set{"beta", "alpha", "gamma"};
+        const std::string_view key = "beta";
+        assert(set.Contains(key) && set.Find(std::string_view("delta")) == set.end());
+        assert(set.Erase(key) == 1 && set.Size() == 2);
+
+        FlatSet<std::string, std::less<>> sorted(sorted_unique, set.begin(), set.end());
+        assert(sorted == set);
+    }
+    {
+        FlatMap<std::string, int, std::less<>> map{{"one", 1}, {"three", 3}, {"one", 100}};
+        assert(map.Size() == 2 && map.At("one") == 1);
+        map["two"] = 2;
+        ++map["two"];
+        assert(map.At(std::string_view("two")) == 3);
+        assert(!map.TryEmplace("three", 30).second && map.At("three") == 3);
+        assert(!map.InsertOrAssign("three", 30).second && map.At("three") == 30);
+        try {
+            map.At("four");
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+
+        // Повторы внутри пакета и с прежними ключами не заменяют существующие значения
+        const std::vector<std::pair<std::string, int>> batch{{"zero", 0}, {"two", 200}, {"four", 4}, {"zero", -1}};
+        map.Insert(batch.begin(), batch.end());
+        assert(map.Size() == 5 && map.At("zero") == 0 && map.At("two") == 3 && map.At("four") == 4);
+        assert(std::is_sorted(map.begin(), map.end()));
+        assert(map.Erase(std::string_view("one")) == 1 && !map.Contains("one"));
+
+        const FlatMap<std::string, int, std::less<>>& view = map;
+        assert(view.Find("four")->second == 4 && view.LowerBound("zz") == view.end());
+    }
+    {
+        // Составной ключ сравнивается целиком, а не по первому полю
+        using Point = std::pair<int, int>;
+        FlatMap<Point, int> grid{{{1, 2}, 12}, {{0, 5}, 5}, {{1, 0}, 10}};
+        assert(grid.Size() == 3 && grid.begin()->first == Point(0, 5));
+        grid[Point(1, 1)] = 11;
+        assert(grid.At(Point(1, 1)) == 11 && grid.Find(Point(1, 3)) == grid.end());
+        assert(grid.LowerBound(Point(1, 1))->second == 11 && grid.UpperBound(Point(1, 1))->second == 12);
+        assert(grid.Erase(Point(1, 0)) == 1 && grid.Size() == 3);
+    }
+    {
+        // Если копирование элемента пакета выбрасывает исключение, множество не меняется
+        struct BlockLess {
+            bool operator()(const Block& lhs, const Block& rhs) const noexcept {
+                return lhs.value < rhs.value;
+            }
+        };
+        FlatSet<Block, BlockLess> blocks;
+        blocks.Reserve(8);
+        const Block a(1);
+        const Block b(2);
+        blocks.Insert(a);
+        const std::vector<Block> batch{b, a};
+        Block::throw_on_copy_value = 1;
+        try {
+            blocks.Insert(batch.begin(), batch.end());
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        Block::throw_on_copy_value = -1;
+        assert(blocks.Size() == 1 && blocks.begin()->value == 1);
+
+        FlatMap<int, Block> map{{1, Block(10)}, {3, Block(30)}};
+        const std::vector<std::pair<int, Block>> pairs{{2, Block(20)}, {4, Block(40)}};
+        Block::throw_on_copy_value = 40;
+        try {
+            map.Insert(pairs.begin(), pairs.end());
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        Block::throw_on_copy_value = -1;
+        assert(map.Size() == 2 && map.At(1).value == 10 && map.At(3).value == 30);
+    }
+    {
+        // Исключение из сравнения при сортировке новых ключей сохраняет прежние ключи,
+        // а исключение при слиянии с ними очищает множество
+        struct ThrowingLess {
+            bool operator()(int lhs, int rhs) const {
+                if (lhs == 100 || rhs == 100) {
+                    throw std::runtime_error("ThrowingLess");
+                }
+                return lhs < rhs;
+            }
+        };
+        FlatSet<int, ThrowingLess> set{1, 2, 3};
+        const std::vector<int> unsorted{100, 5};
+        try {
+            set.Insert(unsorted.begin(), unsorted.end());
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(set == (FlatSet<int, ThrowingLess>{1, 2, 3}));
+        const std::vector<int> single{100};
+        try {
+            set.Insert(single.begin(), single.end());
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(set.Empty());
+    }
+}
+
+void Test30() {
+    {
+        // Очередь FIFO: после заполнения буфера элементы продолжаются с его начала
+        RingVector<int> ring;
+        ring.Reserve(4);
+        for (int i = 0; i < 4; ++i) {
+            ring.PushBack(i);
+        }
+        ring.PopFront();
+        ring.PopFront();
+        ring.PushBack(4);
+        ring.PushBack(5);
+        assert(ring.Capacity() == 4 && ring.Size() == 4 && ring.Front() == 2 && ring.Back() == 5);
+        const auto [first, second] = ring.AsSpans();
+        assert(first.Size() == 2 && first[0] == 2 && second.Size() == 2 && second[1] == 5);
+
+        // Рост переносит разорванные элементы в новый буфер по порядку
+        ring.PushBack(6);
+        assert(ring.Capacity() > 4 && ring.AsSpans().second.Empty());
+        const std::vector<int> expected{2, 3, 4, 5, 6};
+        assert(std::equal(ring.begin(), ring.end(), expected.begin(), expected.end()));
+
+        ring.PushFront(1);
+        ring.PushFront(0);
+        assert(ring.Front() == 0 && ring[2] == 2 && ring.Size() == 7);
+        ring.PopBack();
+        assert(ring.Back() == 5);
+
+        RingVector<int> copy(ring);
+        assert(std::equal(copy.begin(), copy.end(), ring.begin(), ring.end()));
+        copy.ShrinkToFit();
+        assert(copy.Capacity() == copy.Size() && copy[5] == 5);
+    }
+    {
+        // PushFront в пустой вектор выделяет буфер и размещает элемент в его начале
+        RingVector<std::string> ring;
+        ring.PushFront("b");
+        ring.EmplaceFront("a");
+        ring.EmplaceBack(2, 'c');
+        assert(ring.Size() == 3 && ring[0] == "a" && ring[1] == "b" && ring[2] == "cc");
+        // Аргумент может ссылаться на элемент, который переносится при росте
+        ring.ShrinkToFit();
+        ring.PushBack(ring.Front());
+        assert(ring.Back() == "a");
+        ring.Clear();
+        assert(ring.Empty());
+    }
+    {
+        // Исключение при копировании во время роста оставляет буфер нетронутым
+        RingVector<Block> ring;
+        ring.Reserve(2);
+        ring.EmplaceBack(1);
+        ring.EmplaceBack(2);
+        ring.PopFront();
+        ring.EmplaceBack(3);
+        const int alive = Block::alive;
+        Block::throw_on_copy_value = 3;
+        try {
+            ring.EmplaceFront(0);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        Block::throw_on_copy_value = -1;
+        assert(Block::alive == alive && ring.Capacity() == 2);
+        assert(ring.Front().value == 2 && ring.Back().value == 3);
+    }
+    {
+        // Закольцованная очередь не выделяет память после заполнения
+        AllocationCounters counters;
+        RingVector<Obj, CountingAllocator<Obj>> ring{CountingAllocator<Obj>(&counters)};
+        for (int i = 0; i < 8; ++i) {
+            ring.EmplaceBack(i);
+        }
+        const int allocations = counters.num_allocations;
+        for (int i = 8; i < 1000; ++i) {
+            ring.PopFront();
+            ring.EmplaceBack(i);
+        }
+        assert(counters.num_allocations == allocations && ring.Front().id == 992);
+    }
+}
+
+void Test31() {
+    using StrongVector = Vector<LegacyMovable>;
+    using BasicVector = BasicRelocationVector<LegacyMovable>;
+    {
+        // По умолчанию элементы с выбрасывающим перемещением копируются ради строгой гарантии
+        LegacyMovable::ResetCounters();
+        StrongVector v;
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Reserve(100);
+        assert(LegacyMovable::num_copied > 0 && LegacyMovable::num_moved == 0);
+    }
+    {
+        LegacyMovable::ResetCounters();
+        BasicVector v;
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Reserve(100);
+        v.Insert(v.begin() + 1, LegacyMovable(10));
+        v.ShrinkToFit();
+        assert(LegacyMovable::num_copied == 0 && LegacyMovable::num_moved > 0);
+        assert(v.Size() == 5 && v[1].id == 10 && v[4].id == 3);
+    }
+    {
+        // Исключение при перемещении оставляет прежние буфер и размер, а элементы - допустимыми
+        LegacyMovable::ResetCounters();
+        BasicVector v;
+        v.Reserve(4);
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack(i);
+        }
+        LegacyMovable::throw_on_move_id = 2;
+        const LegacyMovable* data = v.Data();
+        try {
+            v.Reserve(8);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 4 && v.Capacity() == 4 && v.Data() == data);
+        assert(v[2].id == 2 && v[3].id == 3);
+        LegacyMovable::throw_on_move_id = -1;
+        v.EmplaceBack(4);
+        assert(v.Size() == 5 && v[4].id == 4);
+    }
+    {
+        // Политика доступна и для SmallVector
+        BasicRelocationSmallVector<LegacyMovable, 2> v;
+        LegacyMovable::ResetCounters();
+        for (int i = 0; i < 5; ++i) {
+            v.EmplaceBack(i);
+        }
+        assert(LegacyMovable::num_copied == 0 && v[4].id == 4);
+    }
+    {
+        // RingVector переносит элементы по той же политике, что и Vector
+        RingVector<LegacyMovable> strong;
+        RingVector<LegacyMovable, std::allocator<LegacyMovable>, DoublingGrowth<>, BasicRelocation> basic;
+        LegacyMovable::ResetCounters();
+        for (int i = 0; i < 5; ++i) {
+            strong.EmplaceBack(i);
+        }
+        assert(LegacyMovable::num_copied > 0 && LegacyMovable::num_moved == 0);
+        LegacyMovable::ResetCounters();
+        for (int i = 0; i < 5; ++i) {
+            basic.EmplaceFront(i);
+        }
+        assert(LegacyMovable::num_copied == 0 && basic.Front().id == 4 && basic.Back().id == 0);
+    }
+}
+
+// Заполняет вектор в константном выражении
+constexpr StaticVector<int, 8> MakeStaticSquares() {
+    StaticVector<int, 8> v;
+    for (int i = 1; i <= 5; ++i) {
+        v.PushBack(i * i);
+    }
+    v.Insert(v.begin(), 0);
+    v.Erase(v.begin() + 2);
+    v.Insert(v.begin() + 1, 2, 7);
+    return v;
+}
+
+void Test32() {
+    {
+        constexpr StaticVector<int, 8> squares = MakeStaticSquares();
+        static_assert(squares.Size() == 7 && squares[0] == 0 && squares[1] == 7 && squares[3] == 1);
+        static_assert(squares[4] == 9 && squares[6] == 25);
+        static_assert(std::is_trivially_copyable_v<StaticVector<int, 8>>);
+        static_assert(!std::is_trivially_copyable_v<StaticVector<std::string, 8>>);
+
+        struct Header {
+            uint16_t type = 0;
+            uint16_t length = 0;
+        };
+        static_assert(std::is_trivially_copyable_v<StaticVector<Header, 4>> && !std::is_trivial_v<Header>);
+        StaticVector<Header, 4> headers;
+        headers.EmplaceBack().type = 1;
+        const StaticVector<Header, 4> copy = headers;
+        assert(copy.Size() == 1 && copy[0].type == 1 && copy[0].length == 0);
+    }
+    {
+        StaticVector<int, 4> v{1, 2, 3};
+        v.PushBack(4);
+        assert(v.TryEmplaceBack(5) == nullptr);
+        try {
+            v.PushBack(5);
+            assert(false);
+        } catch (const std::length_error&) {
+        }
+        const int extra[] = {8, 9};
+        try {
+            v.Insert(v.begin(), std::begin(extra), std::end(extra));
+            assert(false);
+        } catch (const std::length_error&) {
+        }
+        assert((v == StaticVector<int, 4>{1, 2, 3, 4}));
+        assert(v.EraseIf([](int x) {
+                   return x % 2 == 0;
+               }) == 2);
+        v.Insert(v.begin() + 1, std::begin(extra), std::end(extra));
+        assert((v == StaticVector<int, 4>{1, 8, 9, 3}));
+        assert(*v.SwapErase(v.begin()) == 3 && v.Size() == 3);
+        try {
+            v.At(3);
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+    }
+    {
+        // Нетривиальные элементы конструируются и разрушаются только в занятых ячейках
+        Obj::ResetCounters();
+        {
+            StaticVector<Obj, 6> v;
+            v.EmplaceBack(1);
+            v.EmplaceBack(2, "two");
+            v.Insert(v.begin(), Obj(0));
+            v.Insert(v.begin() + 1, 2, v[2]);
+            assert(v.Size() == 5 && v[0].id == 0 && v[1].id == 2 && v[2].id == 2 && v[3].id == 1);
+            v.Erase(v.begin(), v.begin() + 2);
+            assert(v.Size() == 3 && v[0].id == 2 && v[2].id == 2);
+
+            StaticVector<Obj, 6> other(2);
+            other.Swap(v);
+            assert(v.Size() == 2 && other.Size() == 3 && other[1].id == 1);
+            v = other;
+            assert(v.Size() == 3 && v[1].id == 1);
+            v.Resize(1);
+            StaticVector<Obj, 6> moved(std::move(other));
+            assert(moved.Size() == 3 && Obj::GetAliveObjectCount() == 1 + 3 + 3);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        // Исключение при копировании вставляемых элементов оставляет вектор прежним
+        StaticVector<std::string, 4> v{"a", "b"};
+        StaticVector<Block, 4> blocks;
+        blocks.EmplaceBack(1);
+        const Block range[] = {Block(3), Block(2)};
+        const int alive = Block::alive;
+        Block::throw_on_copy_value = 2;
+        try {
+            blocks.Insert(blocks.begin(), std::begin(range), std::end(range));
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        Block::throw_on_copy_value = -1;
+        assert(blocks.Size() == 1 && blocks[0].value == 1 && Block::alive == alive);
+        v.Insert(v.begin() + 1, "x");
+        assert(v.Size() == 3 && v[1] == "x" && v[2] == "b");
+    }
+}
+
+void Test33() {
+    using Allocator = RecyclingAllocator<int>;
+    Allocator::ReleaseThreadCache();
+    {
+        // Буфер разрушенного вектора достаётся следующему вектору того же класса размера
+        const int* data = nullptr;
+        {
+            RecyclingVector<int> v(100);
+            data = v.Data();
+        }
+        assert(Allocator::ThreadCachedBytes() == 512);
+        RecyclingVector<int> v(120);
+        assert(v.Data() == data && Allocator::ThreadCachedBytes() == 0);
+
+        // Рост вектора возвращает прежние буферы в кэш
+        RecyclingVector<std::string> strings;
+        for (int i = 0; i < 1000; ++i) {
+            strings.PushBack(std::to_string(i));
+        }
+        assert(strings[999] == "999" && Allocator::ThreadCachedBytes() > 0);
+    }
+    {
+        // Крупные блоки не кэшируются
+        Allocator::ReleaseThreadCache();
+        {
+            RecyclingVector<char> large(detail::RecyclingPool::kMaxRecycledBytes + 1);
+        }
+        assert(Allocator::ThreadCachedBytes() == 0);
+
+        // Кэш класса размера ограничен
+        std::vector<RecyclingVector<char>> buffers;
+        for (size_t i = 0; i < 2 * detail::RecyclingPool::kMaxCachedBytes / 4096; ++i) {
+            buffers.emplace_back(4096);
+        }
+        buffers.clear();
+        assert(Allocator::ThreadCachedBytes() == detail::RecyclingPool::kMaxCachedBytes);
+        Allocator::ReleaseThreadCache();
+        assert(Allocator::ThreadCachedBytes() == 0);
+    }
+    {
+        // Буфер, освобождённый в другом потоке, пополняет кэш этого потока
+        auto v = std::make_unique<RecyclingVector<int>>(10);
+        size_t cached_in_thread = 0;
+        std::thread([&v, &cached_in_thread] {
+            v.reset();
+            cached_in_thread = Allocator::ThreadCachedBytes();
+        }).join();
+        assert(cached_in_thread == 64 && Allocator::ThreadCachedBytes() == 0);
+    }
+}
+
+void Test34() {
+    {
+        Obj::ResetCounters();
+        Vector<Obj> source;
+        for (int i = 0; i < 4; ++i) {
+            source.EmplaceBack(i);
+        }
+        const CowVector<Obj> original(std::move(source));
+        assert(Obj::num_copied == 0 && original.Size() == 4);
+
+        // Копии разделяют буфер и не копируют элементы
+        CowVector<Obj> copy = original;
+        assert(copy.Data() == original.Data() && copy.IsShared() && Obj::num_copied == 0);
+        assert(copy[3].id == 3);
+
+        // Первое изменение копирует элементы один раз, не затрагивая оригинал
+        copy.MutableAt(0).id = 100;
+        assert(Obj::num_copied == 4 && copy.Data() != original.Data() && !copy.IsShared());
+        assert(copy[0].id == 100 && original[0].id == 0);
+        copy.EmplaceBack(4);
+        copy.Mutate().Erase(copy.Mutate().begin() + 1);
+        assert(Obj::num_copied == 4 && copy.Size() == 4 && copy[1].id == 2);
+
+        // Очистка разделённого вектора только отпускает буфер
+        CowVector<Obj> cleared = original;
+        cleared.Clear();
+        assert(cleared.Empty() && original.Size() == 4 && Obj::num_copied == 4);
+        cleared.PushBack(Obj(7));
+        assert(cleared.Size() == 1 && cleared.At(0).id == 7);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Потоки читают свои копии и изменяют их независимо друг от друга
+        Vector<int> values(10'000);
+        for (size_t i = 0; i < values.Size(); ++i) {
+            values[i] = static_cast<int>(i);
+        }
+        const CowVector<int> snapshot(std::move(values));
+        std::atomic<bool> ok{true};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t) {
+            readers.emplace_back([&snapshot, t, &ok]() {
+                CowVector<int> local = snapshot;
+                const int* shared = local.Data();
+                long long sum = 0;
+                for (int value : local) {
+                    sum += value;
+                }
+                local.MutableAt(0) = t + 1;
+                if (sum != 10'000LL * 9'999 / 2 || local.Data() == shared || local[0] != t + 1 || local == snapshot) {
+                    ok = false;
+                }
+            });
+        }
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        assert(ok && snapshot[0] == 0 && !snapshot.IsShared());
+    }
+    {
+        CowVector<std::string> empty;
+        assert(empty.Empty() && empty.begin() == empty.end() && !empty.IsShared());
+        empty.Resize(2);
+        assert(empty.Size() == 2 && empty[1].empty());
     }
 }
 
@@ -652,7 +2396,34 @@ int main() {
         Test4();
         Test5();
         Test6();
-        Benchmark();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+        Test26();
+        Test27();
+        Test28();
+        Test29();
+        Test30();
+        Test31();
+        Test32();
+        Test33();
+        Test34();
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
     }
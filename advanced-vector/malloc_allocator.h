@@ -0,0 +1,128 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Аллокатор поверх malloc/realloc. Помимо allocate/deallocate предоставляет reallocate,
+// при помощи которого RawMemory может расширять буфер тривиально перемещаемых элементов
+// без копирования. На Linux блоки от MmapThreshold байт отображаются напрямую через mmap
+// и растут при помощи mremap, что позволяет ядру переносить страницы, а не их содержимое
+template <typename T, size_t MmapThreshold = (size_t{32} << 20)>
+class MallocAllocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "MallocAllocator does not support over-aligned types");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = MallocAllocator<U, MmapThreshold>;
+    };
+
+    MallocAllocator() noexcept = default;
+
+    template <typename U>
+    MallocAllocator(const MallocAllocator<U, MmapThreshold>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        const size_t bytes = GetBytes(n);
+#if defined(__linux__)
+        if (IsMapped(bytes)) {
+            void* p = mmap(nullptr, RoundUpToPage(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(p);
+        }
+#endif
+        void* p = std::malloc(bytes);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+#if defined(__linux__)
+        const size_t bytes = n * sizeof(T);
+        if (IsMapped(bytes)) {
+            munmap(p, RoundUpToPage(bytes));
+            return;
+        }
+#else
+        (void)n;
+#endif
+        std::free(p);
+    }
+
+    // Изменяет размер блока p с old_n до new_n элементов, сохраняя побайтово первые
+    // min(old_n, new_n) элементов. При нехватке памяти выбрасывает std::bad_alloc,
+    // оставляя исходный блок нетронутым
+    T* reallocate(T* p, size_t old_n, size_t new_n) {
+        const size_t new_bytes = GetBytes(new_n);
+#if defined(__linux__)
+        const size_t old_bytes = old_n * sizeof(T);
+        if (IsMapped(old_bytes) && IsMapped(new_bytes)) {
+            void* q = mremap(p, RoundUpToPage(old_bytes), RoundUpToPage(new_bytes), MREMAP_MAYMOVE);
+            if (q == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(q);
+        }
+        if (IsMapped(old_bytes) || IsMapped(new_bytes)) {
+            // Блок переходит между кучей и отдельным отображением - без копирования не обойтись
+            T* q = allocate(new_n);
+            std::memcpy(static_cast<void*>(q), static_cast<const void*>(p), std::min(old_bytes, new_bytes));
+            deallocate(p, old_n);
+            return q;
+        }
+#else
+        (void)old_n;
+#endif
+        void* q = std::realloc(static_cast<void*>(p), new_bytes);
+        if (q == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(q);
+    }
+
+    template <typename U>
+    bool operator==(const MallocAllocator<U, MmapThreshold>& /*other*/) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const MallocAllocator<U, MmapThreshold>& /*other*/) const noexcept {
+        return false;
+    }
+
+private:
+    static size_t GetBytes(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return n * sizeof(T);
+    }
+
+#if defined(__linux__)
+    static bool IsMapped(size_t bytes) noexcept {
+        return bytes >= MmapThreshold;
+    }
+
+    static size_t RoundUpToPage(size_t bytes) noexcept {
+        static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return (bytes + page_size - 1) / page_size * page_size;
+    }
+#endif
+};
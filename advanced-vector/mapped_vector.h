@@ -0,0 +1,320 @@
+#pragma once
+#include "span.h"
+#include "vector.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Заголовок файла MappedVector. Занимает первые kMappedHeaderSize байт файла, за ним следуют элементы
+struct MappedVectorHeader {
+    static constexpr uint64_t kMagic = 0x3150414D43455641;  // "AVECMAP1" в little-endian
+    static constexpr uint32_t kVersion = 1;
+
+    uint64_t magic;
+    uint32_t version;
+    uint32_t element_size;
+    uint32_t element_alignment;
+    uint32_t reserved;
+    uint64_t size;
+};
+
+// Размер заголовка выбран так, чтобы элементы в файле начинались с границы строки кэша
+inline constexpr size_t kMappedHeaderSize = 64;
+
+static_assert(sizeof(MappedVectorHeader) <= kMappedHeaderSize);
+
+// Вектор тривиально копируемых элементов, хранящийся в файле, отображённом в память через mmap.
+// Размер и раскладка элементов записаны в заголовке файла, поэтому повторное открытие файла не
+// требует десериализации: элементы доступны сразу после отображения. Вместимость определяется
+// длиной файла; при росте файл удлиняется через ftruncate и отображается заново. Изменения
+// попадают в файл средствами ядра, а Flush() дожидается их записи на диск
+template <typename T, typename GrowthPolicy = DoublingGrowth<>>
+class MappedVector {
+    static_assert(std::is_trivially_copyable_v<T>, "MappedVector requires trivially copyable elements");
+    static_assert(alignof(T) <= kMappedHeaderSize, "MappedVector does not support element alignment above 64");
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    // Открывает файл path, создавая пустой вектор, если файла нет. Если файл содержит вектор
+    // элементов другого размера или выравнивания, выбрасывает std::runtime_error
+    explicit MappedVector(const std::string& path) {
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            ThrowSystemError("open");
+        }
+        try {
+            struct stat info {};
+            if (::fstat(fd_, &info) != 0) {
+                ThrowSystemError("fstat");
+            }
+            const bool created = info.st_size == 0;
+            if (created) {
+                Truncate(kMappedHeaderSize);
+            } else if (static_cast<size_t>(info.st_size) < kMappedHeaderSize) {
+                throw std::runtime_error("MappedVector: file is too short to hold a header");
+            }
+            Map(created ? kMappedHeaderSize : static_cast<size_t>(info.st_size));
+            if (created) {
+                *Header() = MappedVectorHeader{MappedVectorHeader::kMagic, MappedVectorHeader::kVersion,
+                                               sizeof(T), alignof(T), 0, 0};
+            } else {
+                ValidateHeader();
+            }
+        } catch (...) {
+            Close();
+            throw;
+        }
+    }
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    MappedVector(MappedVector&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1))
+        , mapping_(std::exchange(other.mapping_, nullptr))
+        , length_(std::exchange(other.length_, 0))
+    {
+    }
+
+    MappedVector& operator=(MappedVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Close();
+            fd_ = std::exchange(rhs.fd_, -1);
+            mapping_ = std::exchange(rhs.mapping_, nullptr);
+            length_ = std::exchange(rhs.length_, 0);
+        }
+        return *this;
+    }
+
+    ~MappedVector() {
+        Close();
+    }
+
+    // Удлиняет файл так, чтобы в нём поместились new_capacity элементов
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > Capacity()) {
+            Remap(kMappedHeaderSize + GetBytes(new_capacity));
+        }
+    }
+
+    // Укорачивает файл до текущего размера вектора
+    void ShrinkToFit() {
+        if (Size() < Capacity()) {
+            Remap(kMappedHeaderSize + Size() * sizeof(T));
+        }
+    }
+
+    // Новые элементы инициализируются значением
+    void Resize(size_t new_size) {
+        const size_t size = Size();
+        if (new_size > size) {
+            Reserve(new_size);
+            std::fill(Data() + size, Data() + new_size, T());
+        }
+        Header()->size = new_size;
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        const size_t size = Size();
+        if (size == Capacity()) {
+            // Аргументы могут ссылаться на элементы, поэтому значение создаётся до переотображения
+            T value(std::forward<Args>(args)...);
+            Reserve(GrowthPolicy::NextCapacity(Capacity(), size + 1, sizeof(T)));
+            Data()[size] = value;
+        } else {
+            ::new (static_cast<void*>(Data() + size)) T(std::forward<Args>(args)...);
+        }
+        Header()->size = size + 1;
+        return Data()[size];
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PopBack() noexcept {
+        assert(Size() != 0);
+        --Header()->size;
+    }
+
+    void Clear() noexcept {
+        Header()->size = 0;
+    }
+
+    // Синхронно записывает изменённые страницы в файл
+    void Flush() {
+        if (::msync(mapping_, length_, MS_SYNC) != 0) {
+            ThrowSystemError("msync");
+        }
+    }
+
+    iterator begin() noexcept {
+        return Data();
+    }
+
+    iterator end() noexcept {
+        return Data() + Size();
+    }
+
+    const_iterator begin() const noexcept {
+        return Data();
+    }
+
+    const_iterator end() const noexcept {
+        return Data() + Size();
+    }
+
+    // Перемещённый объект не владеет отображением и ведёт себя как пустой вектор
+    size_t Size() const noexcept {
+        return mapping_ != nullptr ? static_cast<size_t>(Header()->size) : 0;
+    }
+
+    size_t Capacity() const noexcept {
+        return mapping_ != nullptr ? (length_ - kMappedHeaderSize) / sizeof(T) : 0;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < Size());
+        return Data()[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < Size());
+        return Data()[index];
+    }
+
+    const T* Data() const noexcept {
+        if (mapping_ == nullptr) {
+            return nullptr;
+        }
+        return reinterpret_cast<const T*>(static_cast<const unsigned char*>(mapping_) + kMappedHeaderSize);
+    }
+
+    T* Data() noexcept {
+        if (mapping_ == nullptr) {
+            return nullptr;
+        }
+        return reinterpret_cast<T*>(static_cast<unsigned char*>(mapping_) + kMappedHeaderSize);
+    }
+
+    Span<const T> AsSpan() const noexcept {
+        return {Data(), Size()};
+    }
+
+    Span<T> AsSpan() noexcept {
+        return {Data(), Size()};
+    }
+
+private:
+    [[noreturn]] static void ThrowSystemError(const char* operation) {
+        throw std::system_error(errno, std::generic_category(), std::string("MappedVector: ") + operation);
+    }
+
+    static size_t GetBytes(size_t n) {
+        if (n > (std::numeric_limits<size_t>::max() - kMappedHeaderSize) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return n * sizeof(T);
+    }
+
+    const MappedVectorHeader* Header() const noexcept {
+        return static_cast<const MappedVectorHeader*>(mapping_);
+    }
+
+    MappedVectorHeader* Header() noexcept {
+        return static_cast<MappedVectorHeader*>(mapping_);
+    }
+
+    void ValidateHeader() const {
+        const MappedVectorHeader& header = *Header();
+        if (header.magic != MappedVectorHeader::kMagic || header.version != MappedVectorHeader::kVersion) {
+            throw std::runtime_error("MappedVector: file does not contain a mapped vector");
+        }
+        if (header.element_size != sizeof(T) || header.element_alignment != alignof(T)) {
+            throw std::runtime_error("MappedVector: file was written with a different element layout");
+        }
+        if (header.size > Capacity()) {
+            throw std::runtime_error("MappedVector: file is shorter than its recorded size");
+        }
+    }
+
+    // Изменяет только длину файла: length_ всегда равна длине отображения
+    void Truncate(size_t length) {
+        if (::ftruncate(fd_, static_cast<off_t>(length)) != 0) {
+            ThrowSystemError("ftruncate");
+        }
+    }
+
+    void Map(size_t length) {
+        void* p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) {
+            ThrowSystemError("mmap");
+        }
+        mapping_ = p;
+        length_ = length;
+    }
+
+    // Изменяет длину файла и отображения. При ошибке вектор остаётся прежним. Файл удлиняется до
+    // переотображения, а укорачивается после него, чтобы отображение не выходило за конец файла.
+    // Ошибка укорачивания файла не изменяет вектор: файл лишь остаётся длиннее отображения
+    void Remap(size_t new_length) {
+        const size_t old_length = length_;
+        const bool grow = new_length > old_length;
+        if (grow) {
+            Truncate(new_length);
+        }
+#if defined(__linux__)
+        void* p = ::mremap(mapping_, old_length, new_length, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED) {
+            RestoreLengthAndThrow(grow, old_length, "mremap");
+        }
+#else
+        void* p = ::mmap(nullptr, new_length, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) {
+            RestoreLengthAndThrow(grow, old_length, "mmap");
+        }
+        ::munmap(mapping_, old_length);
+#endif
+        mapping_ = p;
+        length_ = new_length;
+        if (!grow) {
+            [[maybe_unused]] const int result = ::ftruncate(fd_, static_cast<off_t>(new_length));
+        }
+    }
+
+    // Возвращает файлу прежнюю длину после неудачного переотображения и сообщает об исходной ошибке.
+    // Ошибка отката игнорируется: отображение не изменилось, а лишняя длина файла безвредна
+    [[noreturn]] void RestoreLengthAndThrow(bool grown, size_t old_length, const char* operation) {
+        const int error = errno;
+        if (grown) {
+            [[maybe_unused]] const int result = ::ftruncate(fd_, static_cast<off_t>(old_length));
+        }
+        errno = error;
+        ThrowSystemError(operation);
+    }
+
+    void Close() noexcept {
+        if (mapping_ != nullptr) {
+            ::munmap(mapping_, length_);
+            mapping_ = nullptr;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    int fd_ = -1;
+    void* mapping_ = nullptr;
+    size_t length_ = 0;
+};
@@ -0,0 +1,183 @@
+#pragma once
+#include "vector.h"
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+namespace detail {
+
+// Кэш освобождённых блоков одного потока. Блоки до kMaxRecycledBytes округляются вверх до степени
+// двойки и после освобождения попадают в список свободных блоков своего класса размера, откуда
+// их забирает следующее выделение того же класса. Каждый класс хранит не более kMaxCachedBytes
+// байт, остальные блоки возвращаются operator delete. Блок может быть освобождён в другом потоке:
+// тогда он пополняет кэш этого потока
+class RecyclingPool {
+public:
+    static constexpr size_t kMinBlockBytes = 16;
+    static constexpr size_t kMaxRecycledBytes = size_t{1} << 18;
+    static constexpr size_t kMaxCachedBytes = size_t{1} << 20;
+
+    RecyclingPool() noexcept = default;
+    RecyclingPool(const RecyclingPool&) = delete;
+    RecyclingPool& operator=(const RecyclingPool&) = delete;
+
+    ~RecyclingPool() {
+        Release();
+        destroyed_ = true;
+    }
+
+    // Кэш текущего потока или nullptr, если поток завершается и кэш уже разрушен
+    static RecyclingPool* Local() noexcept {
+        thread_local RecyclingPool pool;
+        return destroyed_ ? nullptr : &pool;
+    }
+
+    // Размер блока, который будет выделен под bytes байт
+    static size_t BlockBytes(size_t bytes) noexcept {
+        return bytes <= kMaxRecycledBytes ? kMinBlockBytes << ClassOf(bytes) : bytes;
+    }
+
+    void* Allocate(size_t bytes) {
+        if (bytes <= kMaxRecycledBytes) {
+            Bucket& bucket = buckets_[ClassOf(bytes)];
+            if (bucket.head != nullptr) {
+                FreeBlock* block = bucket.head;
+                bucket.head = block->next;
+                --bucket.count;
+                cached_bytes_ -= BlockBytes(bytes);
+                return block;
+            }
+        }
+        return ::operator new(BlockBytes(bytes));
+    }
+
+    void Deallocate(void* p, size_t bytes) noexcept {
+        if (bytes <= kMaxRecycledBytes) {
+            const size_t block_bytes = BlockBytes(bytes);
+            Bucket& bucket = buckets_[ClassOf(bytes)];
+            if ((bucket.count + 1) * block_bytes <= kMaxCachedBytes) {
+                bucket.head = ::new (p) FreeBlock{bucket.head};
+                ++bucket.count;
+                cached_bytes_ += block_bytes;
+                return;
+            }
+        }
+        ::operator delete(p);
+    }
+
+    // Возвращает все кэшированные блоки operator delete
+    void Release() noexcept {
+        for (Bucket& bucket : buckets_) {
+            while (bucket.head != nullptr) {
+                ::operator delete(std::exchange(bucket.head, bucket.head->next));
+            }
+            bucket.count = 0;
+        }
+        cached_bytes_ = 0;
+    }
+
+    // Суммарный размер блоков, ожидающих повторного использования
+    size_t CachedBytes() const noexcept {
+        return cached_bytes_;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct Bucket {
+        FreeBlock* head = nullptr;
+        size_t count = 0;
+    };
+
+    static constexpr size_t kClassCount = 15;
+
+    static_assert((kMinBlockBytes << (kClassCount - 1)) == kMaxRecycledBytes);
+
+    static size_t ClassOf(size_t bytes) noexcept {
+        return bytes <= kMinBlockBytes ? 0 : FloorLog2((bytes - 1) / kMinBlockBytes) + 1;
+    }
+
+    // Признак разрушения кэша. Тривиальная переменная остаётся доступной до завершения потока,
+    // поэтому буферы, освобождаемые деструкторами после разрушения кэша, удаляются напрямую
+    static inline thread_local bool destroyed_ = false;
+
+    Bucket buckets_[kClassCount];
+    size_t cached_bytes_ = 0;
+};
+
+}  // namespace detail
+
+// Аллокатор, повторно использующий буферы в пределах потока: освобождённый блок попадает
+// в кэш текущего потока, и следующее выделение близкого размера получает его без обращения
+// к operator new. Подходит для векторов одинакового размера, которые часто создаются и
+// разрушаются. Кэш занимает до RecyclingPool::kMaxCachedBytes на каждый класс размера
+template <typename T>
+class RecyclingAllocator {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "RecyclingAllocator does not support over-aligned types");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    RecyclingAllocator() noexcept = default;
+
+    template <typename U>
+    RecyclingAllocator(const RecyclingAllocator<U>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        const size_t bytes = GetBytes(n);
+        detail::RecyclingPool* pool = detail::RecyclingPool::Local();
+        return static_cast<T*>(pool != nullptr ? pool->Allocate(bytes)
+                                               : ::operator new(detail::RecyclingPool::BlockBytes(bytes)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        detail::RecyclingPool* pool = detail::RecyclingPool::Local();
+        if (pool != nullptr) {
+            pool->Deallocate(p, n * sizeof(T));
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    // Освобождает блоки, накопленные в кэше текущего потока
+    static void ReleaseThreadCache() noexcept {
+        if (detail::RecyclingPool* pool = detail::RecyclingPool::Local()) {
+            pool->Release();
+        }
+    }
+
+    // Объём памяти в кэше текущего потока
+    static size_t ThreadCachedBytes() noexcept {
+        const detail::RecyclingPool* pool = detail::RecyclingPool::Local();
+        return pool != nullptr ? pool->CachedBytes() : 0;
+    }
+
+    template <typename U>
+    bool operator==(const RecyclingAllocator<U>& /*other*/) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const RecyclingAllocator<U>& /*other*/) const noexcept {
+        return false;
+    }
+
+private:
+    static size_t GetBytes(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return n * sizeof(T);
+    }
+};
+
+// Вектор, буферы которого повторно используются через кэш потока
+template <typename T, typename GrowthPolicy = DoublingGrowth<>>
+using RecyclingVector = Vector<T, RecyclingAllocator<T>, GrowthPolicy>;
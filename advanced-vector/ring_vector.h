@@ -0,0 +1,303 @@
+#pragma once
+#include "span.h"
+#include "index_iterator.h"
+#include "vector.h"
+
+#include <cstddef>
+#include <iterator>
+
+// Кольцевой буфер на RawMemory: элементы занимают Size() ячеек подряд, начиная с ячейки head_,
+// и при достижении конца буфера продолжаются с его начала. Добавление и удаление элементов
+// с обоих концов выполняются за O(1), поэтому RingVector подходит для очередей FIFO, где
+// Vector::Erase(begin()) сдвигал бы весь хвост. При росте элементы переносятся в новый буфер
+// в порядке следования, начиная с его первой ячейки. RelocationPolicy, как и в Vector, выбирает
+// между строгой гарантией (копирование элементов с выбрасывающим перемещением) и перемещением
+template <typename T, typename Alloc = std::allocator<T>, typename GrowthPolicy = DoublingGrowth<>,
+          typename RelocationPolicy = StrongRelocation>
+class RingVector {
+    using AllocTraits = std::allocator_traits<Alloc>;
+
+    static constexpr bool kRelocateBitwise = detail::can_relocate_bitwise_v<T, Alloc>;
+
+    template <typename Value>
+    using Iterator = detail::IndexIterator<RingVector, Value>;
+
+public:
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+    using allocator_type = Alloc;
+
+    RingVector() = default;
+
+    explicit RingVector(const Alloc& alloc) noexcept
+        : data_(alloc)
+    {
+    }
+
+    RingVector(const RingVector& other)
+        : data_(other.size_, AllocTraits::select_on_container_copy_construction(other.GetAllocator()))
+    {
+        const auto [first, second] = other.AsSpans();
+        detail::UninitializedCopyN(data_.GetAllocator(), first.Data(), first.Size(), data_.GetAddress());
+        try {
+            detail::UninitializedCopyN(data_.GetAllocator(), second.Data(), second.Size(),
+                                       data_.GetAddress() + first.Size());
+        } catch (...) {
+            detail::DestroyN(data_.GetAllocator(), data_.GetAddress(), first.Size());
+            throw;
+        }
+        size_ = other.size_;
+    }
+
+    RingVector(RingVector&& other) noexcept
+        : data_(std::move(other.data_))
+        , head_(std::exchange(other.head_, 0))
+        , size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    RingVector& operator=(const RingVector& rhs) {
+        if (this != &rhs) {
+            RingVector rhs_copy(rhs);
+            Swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    RingVector& operator=(RingVector&& rhs) noexcept {
+        Swap(rhs);
+        return *this;
+    }
+
+    ~RingVector() {
+        Clear();
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > data_.Capacity()) {
+            RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+            RelocateTo(new_data.GetAddress());
+            Adopt(new_data);
+        }
+    }
+
+    void ShrinkToFit() {
+        if (size_ < data_.Capacity()) {
+            RawMemory<T, Alloc> new_data(size_, data_.GetAllocator());
+            RelocateTo(new_data.GetAddress());
+            Adopt(new_data);
+        }
+    }
+
+    // Разрушает все элементы, сохраняя вместимость
+    void Clear() noexcept {
+        while (size_ != 0) {
+            PopBack();
+        }
+        head_ = 0;
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == data_.Capacity()) {
+            return GrowAndEmplace(size_, 0, std::forward<Args>(args)...);
+        }
+        T* slot = data_ + Physical(size_);
+        AllocTraits::construct(data_.GetAllocator(), slot, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    template <typename... Args>
+    T& EmplaceFront(Args&&... args) {
+        if (size_ == data_.Capacity()) {
+            return GrowAndEmplace(0, 1, std::forward<Args>(args)...);
+        }
+        const size_t head = head_ == 0 ? data_.Capacity() - 1 : head_ - 1;
+        T* slot = data_ + head;
+        AllocTraits::construct(data_.GetAllocator(), slot, std::forward<Args>(args)...);
+        head_ = head;
+        ++size_;
+        return *slot;
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushFront(T&& value) {
+        EmplaceFront(std::move(value));
+    }
+
+    void PushFront(const T& value) {
+        EmplaceFront(value);
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        --size_;
+        AllocTraits::destroy(data_.GetAllocator(), data_ + Physical(size_));
+    }
+
+    void PopFront() noexcept {
+        assert(size_ != 0);
+        AllocTraits::destroy(data_.GetAllocator(), data_ + head_);
+        --size_;
+        // Опустевший буфер снова заполняется с начала, чтобы элементы реже разрывались
+        head_ = size_ == 0 || head_ + 1 == data_.Capacity() ? 0 : head_ + 1;
+    }
+
+    const T& Front() const noexcept {
+        assert(size_ != 0);
+        return data_[head_];
+    }
+
+    T& Front() noexcept {
+        assert(size_ != 0);
+        return data_[head_];
+    }
+
+    const T& Back() const noexcept {
+        assert(size_ != 0);
+        return data_[Physical(size_ - 1)];
+    }
+
+    T& Back() noexcept {
+        assert(size_ != 0);
+        return data_[Physical(size_ - 1)];
+    }
+
+    // Элементы в порядке следования в виде двух непрерывных участков: от первого элемента до конца
+    // буфера и от начала буфера. Если элементы не разорваны, второй участок пуст
+    std::pair<Span<const T>, Span<const T>> AsSpans() const noexcept {
+        const size_t first = std::min(size_, data_.Capacity() - head_);
+        return {{data_.GetAddress() + head_, first}, {data_.GetAddress(), size_ - first}};
+    }
+
+    std::pair<Span<T>, Span<T>> AsSpans() noexcept {
+        const size_t first = std::min(size_, data_.Capacity() - head_);
+        return {{data_.GetAddress() + head_, first}, {data_.GetAddress(), size_ - first}};
+    }
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+
+    iterator end() noexcept {
+        return iterator(this, size_);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(this, size_);
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    bool Empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_t Capacity() const noexcept {
+        return data_.Capacity();
+    }
+
+    allocator_type GetAllocator() const noexcept {
+        return data_.GetAllocator();
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[Physical(index)];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return data_[Physical(index)];
+    }
+
+    void Swap(RingVector& other) noexcept {
+        data_.Swap(other.data_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+    }
+
+private:
+    // Номер ячейки буфера, в которой находится элемент с логическим индексом index. Вместимость
+    // задаётся политикой роста и не обязана быть степенью двойки, поэтому вместо маски - сравнение
+    size_t Physical(size_t index) const noexcept {
+        const size_t until_wrap = data_.Capacity() - head_;
+        return index < until_wrap ? head_ + index : index - until_wrap;
+    }
+
+    // Выделяет буфер большей вместимости и создаёт в нём новый элемент в ячейке slot, а затем
+    // переносит существующие элементы, начиная с ячейки offset. Элемент создаётся до переноса,
+    // так как args могут ссылаться на элементы буфера
+    template <typename... Args>
+    T& GrowAndEmplace(size_t slot, size_t offset, Args&&... args) {
+        const size_t new_capacity = GrowthPolicy::NextCapacity(data_.Capacity(), size_ + 1, sizeof(T));
+        RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+        T* element = new_data + slot;
+        AllocTraits::construct(data_.GetAllocator(), element, std::forward<Args>(args)...);
+        try {
+            RelocateTo(new_data + offset);
+        } catch (...) {
+            AllocTraits::destroy(data_.GetAllocator(), element);
+            throw;
+        }
+        Adopt(new_data);
+        ++size_;
+        return *element;
+    }
+
+    // Переносит элементы по порядку в неинициализированную память dest и разрушает исходные.
+    // Если перенос прервётся исключением, исходные элементы остаются на месте: нетронутыми
+    // или, при BasicRelocation, частично перемещёнными
+    void RelocateTo(T* dest) {
+        const auto [first, second] = AsSpans();
+        if constexpr (kRelocateBitwise) {
+            detail::RelocateBitwiseN(first.Data(), first.Size(), dest);
+            detail::RelocateBitwiseN(second.Data(), second.Size(), dest + first.Size());
+        } else {
+            Alloc& alloc = data_.GetAllocator();
+            detail::UninitializedMoveOrCopyN<RelocationPolicy>(alloc, first.Data(), first.Size(), dest);
+            try {
+                detail::UninitializedMoveOrCopyN<RelocationPolicy>(alloc, second.Data(), second.Size(),
+                                                                   dest + first.Size());
+            } catch (...) {
+                detail::DestroyN(alloc, dest, first.Size());
+                throw;
+            }
+            detail::DestroyN(alloc, first.Data(), first.Size());
+            detail::DestroyN(alloc, second.Data(), second.Size());
+        }
+    }
+
+    // Переходит на буфер new_data, в который уже перенесены элементы
+    void Adopt(RawMemory<T, Alloc>& new_data) noexcept {
+        data_.Swap(new_data);
+        head_ = 0;
+    }
+
+    RawMemory<T, Alloc> data_;
+    // Ячейка буфера, в которой находится первый элемент
+    size_t head_ = 0;
+    size_t size_ = 0;
+};
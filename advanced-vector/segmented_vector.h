@@ -0,0 +1,220 @@
+#pragma once
+#include "index_iterator.h"
+#include "vector.h"
+
+#include <cstddef>
+#include <iterator>
+
+namespace detail {
+
+// Раскладка элементов по сегментам геометрически растущего размера: сегмент k вмещает
+// FirstSegmentSize << k элементов, поэтому номер сегмента и смещение в нём вычисляются за O(1)
+template <size_t FirstSegmentSize>
+struct SegmentLayout {
+    static_assert(FirstSegmentSize != 0 && (FirstSegmentSize & (FirstSegmentSize - 1)) == 0,
+                  "First segment size must be a power of two");
+
+    // Наибольшее число сегментов, которое может понадобиться для индексов типа size_t
+    static constexpr size_t kMaxSegments = sizeof(size_t) * 8;
+
+    static size_t SegmentSize(size_t segment) noexcept {
+        return FirstSegmentSize << segment;
+    }
+
+    // Суммарная вместимость первых count сегментов
+    static size_t CapacityOf(size_t count) noexcept {
+        return FirstSegmentSize * ((size_t{1} << count) - 1);
+    }
+
+    static size_t SegmentOf(size_t index) noexcept {
+        return FloorLog2(index / FirstSegmentSize + 1);
+    }
+
+    static size_t OffsetOf(size_t index, size_t segment) noexcept {
+        return index - CapacityOf(segment);
+    }
+};
+
+}  // namespace detail
+
+// Вектор со стабильными адресами элементов. Элементы хранятся в сегментах RawMemory, вместимость
+// которых удваивается, и при росте не перемещаются: указатели и ссылки на элементы остаются
+// действительными до их удаления. Доступ по индексу выполняется за O(1)
+template <typename T, typename Alloc = std::allocator<T>, size_t FirstSegmentSize = 16>
+class SegmentedVector {
+    using AllocTraits = std::allocator_traits<Alloc>;
+    using Layout = detail::SegmentLayout<FirstSegmentSize>;
+
+    template <typename Value>
+    using Iterator = detail::IndexIterator<SegmentedVector, Value>;
+
+public:
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+    using allocator_type = Alloc;
+
+    SegmentedVector() = default;
+
+    explicit SegmentedVector(const Alloc& alloc) noexcept
+        : alloc_(alloc)
+    {
+    }
+
+    SegmentedVector(const SegmentedVector& other)
+        : alloc_(AllocTraits::select_on_container_copy_construction(other.alloc_))
+    {
+        Reserve(other.size_);
+        try {
+            for (const T& value : other) {
+                EmplaceBack(value);
+            }
+        } catch (...) {
+            Clear();
+            throw;
+        }
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+        : alloc_(other.alloc_)
+        , segments_(std::move(other.segments_))
+        , size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    SegmentedVector& operator=(const SegmentedVector& rhs) {
+        if (this != &rhs) {
+            SegmentedVector rhs_copy(rhs);
+            Swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& rhs) noexcept {
+        Swap(rhs);
+        return *this;
+    }
+
+    ~SegmentedVector() {
+        Clear();
+    }
+
+    // Выделяет сегменты, необходимые для хранения new_capacity элементов. Элементы не перемещаются
+    void Reserve(size_t new_capacity) {
+        while (Capacity() < new_capacity) {
+            AddSegment();
+        }
+    }
+
+    // Освобождает сегменты, не содержащие элементов
+    void ShrinkToFit() noexcept {
+        while (segments_.Size() != 0 && Layout::CapacityOf(segments_.Size() - 1) >= size_) {
+            segments_.PopBack();
+        }
+    }
+
+    // Разрушает все элементы, сохраняя вместимость
+    void Clear() noexcept {
+        while (size_ != 0) {
+            PopBack();
+        }
+    }
+
+    // Ссылки на элементы, в том числе переданные в args, остаются действительными
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == Capacity()) {
+            AddSegment();
+        }
+        T* slot = Address(size_);
+        AllocTraits::construct(alloc_, slot, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        --size_;
+        AllocTraits::destroy(alloc_, Address(size_));
+    }
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+
+    iterator end() noexcept {
+        return iterator(this, size_);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(this, size_);
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return Layout::CapacityOf(segments_.Size());
+    }
+
+    allocator_type GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return *Address(index);
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return *Address(index);
+    }
+
+    void Swap(SegmentedVector& other) noexcept {
+        using std::swap;
+        swap(alloc_, other.alloc_);
+        segments_.Swap(other.segments_);
+        swap(size_, other.size_);
+    }
+
+private:
+    void AddSegment() {
+        segments_.EmplaceBack(Layout::SegmentSize(segments_.Size()), alloc_);
+    }
+
+    T* Address(size_t index) noexcept {
+        const size_t segment = Layout::SegmentOf(index);
+        return segments_[segment] + Layout::OffsetOf(index, segment);
+    }
+
+    const T* Address(size_t index) const noexcept {
+        const size_t segment = Layout::SegmentOf(index);
+        return segments_[segment] + Layout::OffsetOf(index, segment);
+    }
+
+    Alloc alloc_;
+    // Перевыделение таблицы переносит только дескрипторы сегментов, но не элементы
+    Vector<RawMemory<T, Alloc>> segments_;
+    size_t size_ = 0;
+};
@@ -0,0 +1,138 @@
+#pragma once
+#include "vector.h"
+
+// Хранилище, которое держит до N элементов во встроенном буфере и переходит
+// на динамическую память RawMemory, как только элементы перестают в нём помещаться
+template <typename T, size_t N, typename Alloc = std::allocator<T>>
+class InlineMemory {
+    static_assert(N > 0, "Inline capacity must be positive");
+
+public:
+    using allocator_type = Alloc;
+
+    static constexpr size_t kInlineCapacity = N;
+
+    InlineMemory() = default;
+
+    explicit InlineMemory(const Alloc& alloc) noexcept
+        : heap_(alloc) {
+    }
+
+    explicit InlineMemory(size_t capacity, const Alloc& alloc = Alloc())
+        : heap_(capacity > N ? capacity : 0, alloc) {
+        UpdateAddress();
+    }
+
+    InlineMemory(const InlineMemory&) = delete;
+
+    // Перемещается только динамический буфер. Элементы встроенного буфера
+    // переносит владелец хранилища, так как только он знает их количество
+    InlineMemory(InlineMemory&& other) noexcept
+        : heap_(std::move(other.heap_)) {
+        UpdateAddress();
+        other.UpdateAddress();
+    }
+
+    InlineMemory& operator=(const InlineMemory& rhs) = delete;
+    InlineMemory& operator=(InlineMemory&& rhs) = delete;
+
+    T* operator+(size_t offset) noexcept {
+        // Разрешается получать адрес ячейки памяти, следующей за последним элементом массива
+        assert(offset <= Capacity());
+        return GetAddress() + offset;
+    }
+
+    const T* operator+(size_t offset) const noexcept {
+        assert(offset <= Capacity());
+        return GetAddress() + offset;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < Capacity());
+        return GetAddress()[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < Capacity());
+        return GetAddress()[index];
+    }
+
+    // Устанавливает новый динамический буфер, отдавая прежний в heap
+    void Swap(RawMemory<T, Alloc>& heap) noexcept {
+        heap_.Swap(heap);
+        UpdateAddress();
+    }
+
+    // Обменивает только динамические буферы хранилищ
+    void Swap(InlineMemory& other) noexcept {
+        heap_.Swap(other.heap_);
+        UpdateAddress();
+        other.UpdateAddress();
+    }
+
+    const T* GetAddress() const noexcept {
+        return address_;
+    }
+
+    T* GetAddress() noexcept {
+        return address_;
+    }
+
+    T* InlineAddress() noexcept {
+        return reinterpret_cast<T*>(inline_);
+    }
+
+    const T* InlineAddress() const noexcept {
+        return reinterpret_cast<const T*>(inline_);
+    }
+
+    bool IsInline() const noexcept {
+        return heap_.Capacity() == 0;
+    }
+
+    size_t Capacity() const noexcept {
+        return IsInline() ? N : heap_.Capacity();
+    }
+
+    bool CanReallocate() const noexcept {
+        return !IsInline() && heap_.CanReallocate();
+    }
+
+    void Reallocate(size_t new_capacity) {
+        heap_.Reallocate(new_capacity);
+        UpdateAddress();
+    }
+
+    const Alloc& GetAllocator() const noexcept {
+        return heap_.GetAllocator();
+    }
+
+    Alloc& GetAllocator() noexcept {
+        return heap_.GetAllocator();
+    }
+
+private:
+    // Вызывается после каждой смены динамического буфера
+    void UpdateAddress() noexcept {
+        address_ = IsInline() ? InlineAddress() : heap_.GetAddress();
+    }
+
+    RawMemory<T, Alloc> heap_;
+    alignas(T) unsigned char inline_[N * sizeof(T)];
+    // Адрес используемого буфера хранится, а не выбирается при каждом обращении: так обращения
+    // к элементам не ветвятся, и компилятор не принимает адреса в динамическом буфере за выход
+    // за границы встроенного
+    T* address_ = InlineAddress();
+};
+
+// Вектор, хранящий до N элементов без обращения к аллокатору
+template <typename T, size_t N, typename Alloc = std::allocator<T>, typename GrowthPolicy = DoublingGrowth<>,
+          typename StatsPolicy = NoVectorStats, typename CheckPolicy = AssertedAccess,
+          typename RelocationPolicy = StrongRelocation>
+using SmallVector = Vector<T, Alloc, GrowthPolicy, InlineMemory<T, N, Alloc>, StatsPolicy, CheckPolicy,
+                           RelocationPolicy>;
+
+// SmallVector с BasicRelocation и остальными политиками по умолчанию
+template <typename T, size_t N, typename Alloc = std::allocator<T>, typename GrowthPolicy = DoublingGrowth<>>
+using BasicRelocationSmallVector = SmallVector<T, N, Alloc, GrowthPolicy, NoVectorStats, AssertedAccess,
+                                               BasicRelocation>;
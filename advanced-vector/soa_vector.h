@@ -0,0 +1,287 @@
+#pragma once
+#include "span.h"
+#include "vector.h"
+
+#include <tuple>
+
+// Вектор записей из полей Fields..., хранящий каждое поле в собственном буфере RawMemory
+// (structure of arrays). Цикл, читающий одно-два поля широкой записи, загружает в кэш только
+// их столбцы. Все столбцы имеют общие размер и вместимость и растут вместе, как Vector с DoublingGrowth
+template <typename... Fields>
+class SoaVector {
+    static_assert(sizeof...(Fields) > 0, "SoaVector requires at least one field");
+
+    using Columns = std::tuple<RawMemory<Fields>...>;
+
+    static constexpr size_t kColumnCount = sizeof...(Fields);
+
+public:
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    SoaVector() = default;
+
+    explicit SoaVector(size_t size)
+        : columns_(AllocateColumns(size))
+    {
+        ForEachColumnWithRollback(
+            [&](auto column) {
+                auto& memory = std::get<decltype(column)::value>(columns_);
+                detail::UninitializedValueConstructN(memory.GetAllocator(), memory.GetAddress(), size);
+            },
+            [&](auto column) {
+                DestroyColumn<decltype(column)::value>(columns_, 0, size);
+            });
+        size_ = size;
+    }
+
+    SoaVector(const SoaVector& other)
+        : columns_(AllocateColumns(other.size_))
+    {
+        ForEachColumnWithRollback(
+            [&](auto column) {
+                constexpr size_t I = decltype(column)::value;
+                auto& memory = std::get<I>(columns_);
+                detail::UninitializedCopyN(memory.GetAllocator(), std::get<I>(other.columns_).GetAddress(), other.size_,
+                                           memory.GetAddress());
+            },
+            [&](auto column) {
+                DestroyColumn<decltype(column)::value>(columns_, 0, other.size_);
+            });
+        size_ = other.size_;
+    }
+
+    SoaVector(SoaVector&& other) noexcept
+        : columns_(std::move(other.columns_))
+        , size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    SoaVector& operator=(const SoaVector& rhs) {
+        if (this != &rhs) {
+            SoaVector rhs_copy(rhs);
+            Swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    SoaVector& operator=(SoaVector&& rhs) noexcept {
+        Swap(rhs);
+        return *this;
+    }
+
+    ~SoaVector() {
+        Clear();
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        Columns new_columns = AllocateColumns(new_capacity);
+        RelocateColumns(new_columns);
+        SwapColumns(new_columns);
+    }
+
+    // Добавляет запись, конструируя каждое поле из соответствующего аргумента
+    template <typename... Args>
+    void EmplaceBack(Args&&... args) {
+        static_assert(sizeof...(Args) == kColumnCount, "EmplaceBack takes one initializer per field");
+        auto values = std::forward_as_tuple(std::forward<Args>(args)...);
+        if (size_ == Capacity()) {
+            // Запись конструируется в новых буферах до переноса, поэтому аргументы могут ссылаться на элементы вектора
+            Columns new_columns = AllocateColumns(DoublingGrowth<>::NextCapacity(Capacity(), size_ + 1, 0));
+            ConstructRow(new_columns, values);
+            try {
+                RelocateColumns(new_columns);
+            } catch (...) {
+                ForEachColumn([&](auto column) {
+                    DestroyColumn<decltype(column)::value>(new_columns, size_, 1);
+                });
+                throw;
+            }
+            SwapColumns(new_columns);
+        } else {
+            ConstructRow(columns_, values);
+        }
+        ++size_;
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        --size_;
+        ForEachColumn([&](auto column) {
+            DestroyColumn<decltype(column)::value>(columns_, size_, 1);
+        });
+    }
+
+    // Удаляет записи с индексами из [first, last), сдвигая последующие записи
+    void Erase(size_t first, size_t last) {
+        assert(first <= last && last <= size_);
+        const size_t count = last - first;
+        ForEachColumn([&](auto column) {
+            constexpr size_t I = decltype(column)::value;
+            FieldType<I>* data = std::get<I>(columns_).GetAddress();
+            std::move(data + last, data + size_, data + first);
+            DestroyColumn<I>(columns_, size_ - count, count);
+        });
+        size_ -= count;
+    }
+
+    void Erase(size_t index) {
+        Erase(index, index + 1);
+    }
+
+    // Разрушает все записи, сохраняя вместимость
+    void Clear() noexcept {
+        ForEachColumn([&](auto column) {
+            DestroyColumn<decltype(column)::value>(columns_, 0, size_);
+        });
+        size_ = 0;
+    }
+
+    void Swap(SoaVector& other) noexcept {
+        SwapColumns(other.columns_);
+        std::swap(size_, other.size_);
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return std::get<0>(columns_).Capacity();
+    }
+
+    // Столбец поля I
+    template <size_t I>
+    Span<FieldType<I>> Column() noexcept {
+        return {std::get<I>(columns_).GetAddress(), size_};
+    }
+
+    template <size_t I>
+    Span<const FieldType<I>> Column() const noexcept {
+        return {std::get<I>(columns_).GetAddress(), size_};
+    }
+
+    // Поле I записи с индексом index
+    template <size_t I>
+    FieldType<I>& Get(size_t index) noexcept {
+        assert(index < size_);
+        return std::get<I>(columns_)[index];
+    }
+
+    template <size_t I>
+    const FieldType<I>& Get(size_t index) const noexcept {
+        assert(index < size_);
+        return std::get<I>(columns_)[index];
+    }
+
+private:
+    // Перенос элементов типа F в новый буфер может выбросить исключение
+    template <typename F>
+    static constexpr bool kMayThrowOnRelocate = !detail::can_relocate_bitwise_v<F, std::allocator<F>>
+        && !std::is_nothrow_move_constructible_v<F>;
+
+    static Columns AllocateColumns(size_t capacity) {
+        return Columns(RawMemory<Fields>(capacity)...);
+    }
+
+    template <size_t I>
+    static void DestroyColumn(Columns& columns, size_t first, size_t count) noexcept {
+        auto& memory = std::get<I>(columns);
+        detail::DestroyN(memory.GetAllocator(), memory + first, count);
+    }
+
+    void SwapColumns(Columns& other) noexcept {
+        ForEachColumn([&](auto column) {
+            constexpr size_t I = decltype(column)::value;
+            std::get<I>(columns_).Swap(std::get<I>(other));
+        });
+    }
+
+    // Вызывает op(std::integral_constant<size_t, I>{}) для каждого столбца I
+    template <typename Operation>
+    static void ForEachColumn(const Operation& op) {
+        ForEachColumn(op, std::index_sequence_for<Fields...>{});
+    }
+
+    template <typename Operation, size_t... I>
+    static void ForEachColumn(const Operation& op, std::index_sequence<I...>) {
+        (op(std::integral_constant<size_t, I>{}), ...);
+    }
+
+    // Вызывает construct для столбцов, начиная с I. Если construct выбросит исключение,
+    // для уже обработанных столбцов вызывается rollback
+    template <size_t I = 0, typename Construct, typename Rollback>
+    static void ForEachColumnWithRollback(const Construct& construct, const Rollback& rollback) {
+        if constexpr (I < kColumnCount) {
+            construct(std::integral_constant<size_t, I>{});
+            try {
+                ForEachColumnWithRollback<I + 1>(construct, rollback);
+            } catch (...) {
+                rollback(std::integral_constant<size_t, I>{});
+                throw;
+            }
+        }
+    }
+
+    // Конструирует запись с индексом size_ в columns из кортежа ссылок на аргументы
+    template <typename Values>
+    void ConstructRow(Columns& columns, Values& values) {
+        ForEachColumnWithRollback(
+            [&](auto column) {
+                constexpr size_t I = decltype(column)::value;
+                auto& memory = std::get<I>(columns);
+                std::allocator_traits<std::allocator<FieldType<I>>>::construct(memory.GetAllocator(), memory + size_,
+                                                                              std::get<I>(std::move(values)));
+            },
+            [&](auto column) {
+                DestroyColumn<decltype(column)::value>(columns, size_, 1);
+            });
+    }
+
+    // Переносит записи в new_columns. Сначала копируются столбцы, перенос которых может выбросить
+    // исключение, и лишь затем перемещаются остальные, поэтому при ошибке вектор остаётся прежним
+    void RelocateColumns(Columns& new_columns) {
+        ForEachColumnWithRollback(
+            [&](auto column) {
+                constexpr size_t I = decltype(column)::value;
+                using F = FieldType<I>;
+                if constexpr (kMayThrowOnRelocate<F>) {
+                    auto& memory = std::get<I>(new_columns);
+                    if constexpr (std::is_copy_constructible_v<F>) {
+                        detail::UninitializedCopyN(memory.GetAllocator(),
+                                                   static_cast<const F*>(std::get<I>(columns_).GetAddress()), size_,
+                                                   memory.GetAddress());
+                    } else {
+                        detail::UninitializedMoveN(memory.GetAllocator(), std::get<I>(columns_).GetAddress(), size_,
+                                                   memory.GetAddress());
+                    }
+                }
+            },
+            [&](auto column) {
+                constexpr size_t I = decltype(column)::value;
+                if constexpr (kMayThrowOnRelocate<FieldType<I>>) {
+                    DestroyColumn<I>(new_columns, 0, size_);
+                }
+            });
+        ForEachColumn([&](auto column) {
+            constexpr size_t I = decltype(column)::value;
+            using F = FieldType<I>;
+            auto& memory = std::get<I>(columns_);
+            if constexpr (detail::can_relocate_bitwise_v<F, std::allocator<F>>) {
+                detail::RelocateBitwiseN(memory.GetAddress(), size_, std::get<I>(new_columns).GetAddress());
+            } else {
+                if constexpr (!kMayThrowOnRelocate<F>) {
+                    detail::UninitializedMoveN(memory.GetAllocator(), memory.GetAddress(), size_,
+                                               std::get<I>(new_columns).GetAddress());
+                }
+                DestroyColumn<I>(columns_, 0, size_);
+            }
+        });
+    }
+
+    Columns columns_;
+    size_t size_ = 0;
+};
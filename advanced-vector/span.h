@@ -0,0 +1,62 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+// Невладеющее представление непрерывной последовательности элементов, аналог std::span из C++20
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    constexpr Span() noexcept = default;
+
+    constexpr Span(T* data, size_t size) noexcept
+        : data_(data)
+        , size_(size) {
+    }
+
+    // Span<T> неявно преобразуется в Span<const T>
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U>& other) noexcept
+        : data_(other.Data())
+        , size_(other.Size()) {
+    }
+
+    constexpr T* Data() const noexcept {
+        return data_;
+    }
+
+    constexpr size_t Size() const noexcept {
+        return size_;
+    }
+
+    constexpr bool Empty() const noexcept {
+        return size_ == 0;
+    }
+
+    constexpr T* begin() const noexcept {
+        return data_;
+    }
+
+    constexpr T* end() const noexcept {
+        return data_ + size_;
+    }
+
+    constexpr T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    // Возвращает count элементов, начиная с offset
+    constexpr Span Subspan(size_t offset, size_t count) const noexcept {
+        assert(offset <= size_ && count <= size_ - offset);
+        return Span(data_ + offset, count);
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
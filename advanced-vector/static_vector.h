@@ -0,0 +1,508 @@
+#pragma once
+#include "span.h"
+#include "vector.h"
+
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+
+namespace detail {
+
+// Хранилище StaticVector для тривиальных типов: обычный массив, поэтому вектор можно создавать
+// и изменять в константных выражениях. Стандарт C++17 требует, чтобы constexpr-конструктор
+// инициализировал все члены, поэтому массив инициализируется нулями
+template <typename T, size_t N>
+class StaticArrayStorage {
+protected:
+    constexpr StaticArrayStorage() noexcept
+        : elements_{}
+    {
+    }
+
+    constexpr T* Elements() noexcept {
+        return elements_;
+    }
+
+    constexpr const T* Elements() const noexcept {
+        return elements_;
+    }
+
+    T elements_[N];
+    size_t size_ = 0;
+};
+
+// Хранилище для тривиально копируемых типов без тривиального конструктора по умолчанию: буфер
+// байтов, элементы которого конструируются по требованию. Копирование и разрушение остаются
+// тривиальными
+template <typename T, size_t N>
+class StaticBytesStorage {
+protected:
+    StaticBytesStorage() noexcept {
+    }
+
+    T* Elements() noexcept {
+        return reinterpret_cast<T*>(buffer_);
+    }
+
+    const T* Elements() const noexcept {
+        return reinterpret_cast<const T*>(buffer_);
+    }
+
+    alignas(T) unsigned char buffer_[N * sizeof(T)];
+    size_t size_ = 0;
+};
+
+// Хранилище для остальных типов: копирует, перемещает и разрушает только существующие элементы
+template <typename T, size_t N>
+class StaticManagedStorage : public StaticBytesStorage<T, N> {
+    using Base = StaticBytesStorage<T, N>;
+
+protected:
+    using Base::Elements;
+    using Base::size_;
+
+    StaticManagedStorage() noexcept = default;
+
+    StaticManagedStorage(const StaticManagedStorage& other) {
+        ConstructFrom(other.Elements(), other.size_);
+    }
+
+    StaticManagedStorage(StaticManagedStorage&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        ConstructFrom(std::make_move_iterator(other.Elements()), other.size_);
+    }
+
+    StaticManagedStorage& operator=(const StaticManagedStorage& rhs) {
+        if (this != &rhs) {
+            AssignFrom(rhs.Elements(), rhs.size_);
+        }
+        return *this;
+    }
+
+    StaticManagedStorage& operator=(StaticManagedStorage&& rhs) noexcept(std::is_nothrow_move_assignable_v<T>
+                                                                         && std::is_nothrow_move_constructible_v<T>) {
+        if (this != &rhs) {
+            AssignFrom(std::make_move_iterator(rhs.Elements()), rhs.size_);
+        }
+        return *this;
+    }
+
+    ~StaticManagedStorage() {
+        std::destroy_n(Elements(), size_);
+    }
+
+private:
+    template <typename InputIt>
+    void ConstructFrom(InputIt src, size_t n) {
+        std::uninitialized_copy_n(src, n, Elements());
+        size_ = n;
+    }
+
+    // Присваивает общую часть и досоздаёт или разрушает остаток
+    template <typename InputIt>
+    void AssignFrom(InputIt src, size_t n) {
+        const size_t common = std::min(size_, n);
+        std::copy_n(src, common, Elements());
+        if (n > size_) {
+            std::uninitialized_copy_n(src + common, n - common, Elements() + common);
+        } else {
+            std::destroy_n(Elements() + n, size_ - n);
+        }
+        size_ = n;
+    }
+};
+
+template <typename T, size_t N>
+using StaticStorage = std::conditional_t<std::is_trivial_v<T>, StaticArrayStorage<T, N>,
+                                         std::conditional_t<std::is_trivially_copyable_v<T>, StaticBytesStorage<T, N>,
+                                                            StaticManagedStorage<T, N>>>;
+
+}  // namespace detail
+
+// Вектор вместимостью не более N элементов, хранящий их в собственном буфере без обращения
+// к куче. Интерфейс повторяет Vector. Добавление элемента в заполненный вектор выбрасывает
+// std::length_error и не меняет вектор, а TryEmplaceBack в этом случае возвращает nullptr.
+// Для тривиальных T все операции доступны в константных выражениях, а для тривиально
+// копируемых T тривиально копируемым является и сам вектор
+template <typename T, size_t N>
+class StaticVector : private detail::StaticStorage<T, N> {
+    static_assert(N > 0, "StaticVector capacity must be positive");
+
+    using Base = detail::StaticStorage<T, N>;
+    using Base::Elements;
+    using Base::size_;
+
+    static constexpr bool kTrivial = std::is_trivial_v<T>;
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+    using value_type = T;
+
+    constexpr StaticVector() noexcept = default;
+
+    constexpr explicit StaticVector(size_t size) {
+        Resize(size);
+    }
+
+    template <typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+    constexpr StaticVector(InputIt first, InputIt last) {
+        Append(first, last);
+    }
+
+    constexpr StaticVector(std::initializer_list<T> values) {
+        Append(values.begin(), values.end());
+    }
+
+    constexpr void Resize(size_t new_size) {
+        CheckCapacity(new_size);
+        while (size_ > new_size) {
+            PopBack();
+        }
+        while (size_ < new_size) {
+            EmplaceBack();
+        }
+    }
+
+    // Разрушает все элементы
+    constexpr void Clear() noexcept {
+        while (size_ != 0) {
+            PopBack();
+        }
+    }
+
+    template <typename... Args>
+    constexpr T& EmplaceBack(Args&&... args) {
+        CheckCapacity(size_ + 1);
+        return *TryEmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Добавляет элемент, если есть свободное место, и возвращает указатель на него, иначе nullptr
+    template <typename... Args>
+    constexpr T* TryEmplaceBack(Args&&... args) {
+        if (size_ == N) {
+            return nullptr;
+        }
+        T* slot = end();
+        Construct(slot, std::forward<Args>(args)...);
+        ++size_;
+        return slot;
+    }
+
+    constexpr void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    constexpr void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    constexpr void PopBack() noexcept {
+        assert(size_ > 0);
+        --size_;
+        Destroy(end());
+    }
+
+    template <typename... Args>
+    constexpr iterator Emplace(const_iterator pos, Args&&... args) {
+        const size_t index = pos - cbegin();
+        CheckCapacity(size_ + 1);
+        if (index == size_) {
+            return &EmplaceBack(std::forward<Args>(args)...);
+        }
+        // Аргументы могут ссылаться на элементы хвоста, поэтому значение создаётся до сдвига
+        T tmp(std::forward<Args>(args)...);
+        T* data = Elements();
+        Construct(end(), std::move(data[size_ - 1]));
+        ++size_;
+        for (size_t i = size_ - 2; i > index; --i) {
+            data[i] = std::move(data[i - 1]);
+        }
+        data[index] = std::move(tmp);
+        return data + index;
+    }
+
+    constexpr iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+
+    constexpr iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Вставляет count копий value перед pos
+    constexpr iterator Insert(const_iterator pos, size_t count, const T& value) {
+        const size_t index = pos - cbegin();
+        CheckCapacity(size_ + count);
+        const size_t old_size = size_;
+        // Копии добавляются в конец, поэтому value может ссылаться на элемент вектора
+        for (size_t i = 0; i < count; ++i) {
+            AppendOrRollback(old_size, value);
+        }
+        Rotate(index, old_size);
+        return begin() + index;
+    }
+
+    // Вставляет элементы диапазона [first, last) перед pos. Если диапазон не помещается, выбрасывает
+    // std::length_error, не меняя вектор. Диапазон не должен ссылаться на элементы самого вектора
+    template <typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+    constexpr iterator Insert(const_iterator pos, InputIt first, InputIt last) {
+        const size_t index = pos - cbegin();
+        if constexpr (detail::is_forward_iterator_v<InputIt>) {
+            CheckCapacity(size_ + static_cast<size_t>(std::distance(first, last)));
+        }
+        const size_t old_size = size_;
+        for (; first != last; ++first) {
+            if (size_ == N) {
+                Truncate(old_size);
+                ThrowLengthError();
+            }
+            AppendOrRollback(old_size, *first);
+        }
+        Rotate(index, old_size);
+        return begin() + index;
+    }
+
+    template <typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+    constexpr void Append(InputIt first, InputIt last) {
+        Insert(cend(), first, last);
+    }
+
+    constexpr iterator Erase(const_iterator pos) {
+        return Erase(pos, pos + 1);
+    }
+
+    // Удаляет элементы [first, last), сдвигая хвост
+    constexpr iterator Erase(const_iterator first, const_iterator last) {
+        const size_t index = first - cbegin();
+        const size_t count = last - first;
+        T* data = Elements();
+        for (size_t i = index; i + count < size_; ++i) {
+            data[i] = std::move(data[i + count]);
+        }
+        Truncate(size_ - count);
+        return data + index;
+    }
+
+    // Удаляет элемент pos за O(1), перемещая на его место последний элемент
+    constexpr iterator SwapErase(const_iterator pos) {
+        const size_t index = pos - cbegin();
+        assert(index < size_);
+        T* data = Elements();
+        if (index != size_ - 1) {
+            data[index] = std::move(data[size_ - 1]);
+        }
+        PopBack();
+        return data + index;
+    }
+
+    // Удаляет за один проход все элементы, удовлетворяющие pred, и возвращает их количество
+    template <typename Predicate>
+    constexpr size_t EraseIf(Predicate pred) {
+        T* data = Elements();
+        size_t kept = 0;
+        for (size_t i = 0; i < size_; ++i) {
+            if (!pred(static_cast<const T&>(data[i]))) {
+                if (kept != i) {
+                    data[kept] = std::move(data[i]);
+                }
+                ++kept;
+            }
+        }
+        const size_t count = size_ - kept;
+        Truncate(kept);
+        return count;
+    }
+
+    constexpr iterator begin() noexcept {
+        return Elements();
+    }
+
+    constexpr iterator end() noexcept {
+        return Elements() + size_;
+    }
+
+    constexpr const_iterator begin() const noexcept {
+        return Elements();
+    }
+
+    constexpr const_iterator end() const noexcept {
+        return Elements() + size_;
+    }
+
+    constexpr const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    constexpr const_iterator cend() const noexcept {
+        return end();
+    }
+
+    constexpr size_t Size() const noexcept {
+        return size_;
+    }
+
+    constexpr bool Empty() const noexcept {
+        return size_ == 0;
+    }
+
+    static constexpr size_t Capacity() noexcept {
+        return N;
+    }
+
+    constexpr const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return Elements()[index];
+    }
+
+    constexpr T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Elements()[index];
+    }
+
+    // Доступ с проверкой индекса, выбрасывающий std::out_of_range
+    constexpr const T& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("StaticVector index out of range");
+        }
+        return Elements()[index];
+    }
+
+    constexpr T& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("StaticVector index out of range");
+        }
+        return Elements()[index];
+    }
+
+    constexpr const T* Data() const noexcept {
+        return Elements();
+    }
+
+    constexpr T* Data() noexcept {
+        return Elements();
+    }
+
+    Span<const T> AsSpan() const noexcept {
+        return {Elements(), size_};
+    }
+
+    Span<T> AsSpan() noexcept {
+        return {Elements(), size_};
+    }
+
+    // Обменивает элементы поэлементно: буферы обоих векторов остаются на месте
+    constexpr void Swap(StaticVector& other) {
+        StaticVector& shorter = size_ <= other.size_ ? *this : other;
+        StaticVector& longer = size_ <= other.size_ ? other : *this;
+        const size_t common = shorter.size_;
+        for (size_t i = 0; i < common; ++i) {
+            SwapElements(shorter.Elements()[i], longer.Elements()[i]);
+        }
+        for (size_t i = common; i < longer.size_; ++i) {
+            shorter.Construct(shorter.end(), std::move(longer.Elements()[i]));
+            ++shorter.size_;
+        }
+        longer.Truncate(common);
+    }
+
+    friend constexpr bool operator==(const StaticVector& lhs, const StaticVector& rhs) {
+        if (lhs.size_ != rhs.size_) {
+            return false;
+        }
+        for (size_t i = 0; i < lhs.size_; ++i) {
+            if (!(lhs[i] == rhs[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend constexpr bool operator!=(const StaticVector& lhs, const StaticVector& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    [[noreturn]] static void ThrowLengthError() {
+        throw std::length_error("StaticVector capacity exceeded");
+    }
+
+    static constexpr void CheckCapacity(size_t required) {
+        if (required > N) {
+            ThrowLengthError();
+        }
+    }
+
+    // У тривиальных типов элементы массива уже существуют, и конструирование сводится к присваиванию
+    template <typename... Args>
+    static constexpr void Construct(T* slot, Args&&... args) {
+        if constexpr (kTrivial) {
+            *slot = T(std::forward<Args>(args)...);
+        } else {
+            ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+        }
+    }
+
+    static constexpr void Destroy([[maybe_unused]] T* slot) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            slot->~T();
+        }
+    }
+
+    static constexpr void SwapElements(T& lhs, T& rhs) {
+        if constexpr (kTrivial) {
+            // std::swap становится constexpr только в C++20
+            T tmp = lhs;
+            lhs = rhs;
+            rhs = tmp;
+        } else {
+            using std::swap;
+            swap(lhs, rhs);
+        }
+    }
+
+    constexpr void Truncate(size_t new_size) noexcept {
+        while (size_ > new_size) {
+            PopBack();
+        }
+    }
+
+    // Добавляет элемент в конец, а при исключении удаляет и все добавленные после old_size
+    template <typename Value>
+    constexpr void AppendOrRollback(size_t old_size, Value&& value) {
+        if constexpr (kTrivial) {
+            // Блоки try недоступны в константных выражениях C++17, а присваивание тривиального
+            // значения откатывать не нужно
+            Construct(end(), std::forward<Value>(value));
+            ++size_;
+        } else {
+            AppendWithRollback(old_size, std::forward<Value>(value));
+        }
+    }
+
+    template <typename Value>
+    void AppendWithRollback(size_t old_size, Value&& value) {
+        try {
+            Construct(end(), std::forward<Value>(value));
+        } catch (...) {
+            Truncate(old_size);
+            throw;
+        }
+        ++size_;
+    }
+
+    // Переставляет элементы [old_size, Size()), добавленные в конец, на позицию index тремя
+    // обращениями, каждое из которых доступно в константных выражениях
+    constexpr void Rotate(size_t index, size_t old_size) {
+        Reverse(index, old_size);
+        Reverse(old_size, size_);
+        Reverse(index, size_);
+    }
+
+    constexpr void Reverse(size_t first, size_t last) {
+        T* data = Elements();
+        while (first + 1 < last) {
+            SwapElements(data[first++], data[--last]);
+        }
+    }
+};
@@ -1,40 +1,528 @@
 #pragma once
+#include "span.h"
+
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <new>
+#include <stdexcept>
+#include <thread>
 #include <utility>
 #include <memory>
 #include <algorithm>
+#include <type_traits>
+
+// Подсказки компилятору для горячих путей: редкая ветвь и функция, которую не следует встраивать
+#if defined(__GNUC__)
+#define VECTOR_UNLIKELY(condition) __builtin_expect(!!(condition), 0)
+#define VECTOR_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define VECTOR_UNLIKELY(condition) (condition)
+#define VECTOR_NOINLINE __declspec(noinline)
+#else
+#define VECTOR_UNLIKELY(condition) (condition)
+#define VECTOR_NOINLINE
+#endif
+
+// Признак того, что объект типа T можно перенести в другую область памяти побайтовым
+// копированием, после чего исходный объект считается разрушенным без вызова деструктора.
+// Типы-дескрипторы, владеющие ресурсом, могут явно специализировать этот шаблон
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {
+};
 
 template <typename T>
-class RawMemory {
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+namespace detail {
+
+template <typename Alloc, typename T, typename = void>
+struct HasCustomConstruct : std::false_type {
+};
+
+template <typename Alloc, typename T>
+struct HasCustomConstruct<Alloc, T, std::void_t<decltype(
+    std::declval<Alloc&>().construct(std::declval<T*>(), std::declval<T&&>()))>> : std::true_type {
+};
+
+template <typename Alloc, typename T, typename = void>
+struct HasCustomDestroy : std::false_type {
+};
+
+template <typename Alloc, typename T>
+struct HasCustomDestroy<Alloc, T, std::void_t<decltype(
+    std::declval<Alloc&>().destroy(std::declval<T*>()))>> : std::true_type {
+};
+
+template <typename Alloc, typename T, typename = void>
+struct HasReallocate : std::false_type {
+};
+
+template <typename Alloc, typename T>
+struct HasReallocate<Alloc, T, std::void_t<decltype(
+    std::declval<Alloc&>().reallocate(std::declval<T*>(), size_t{}, size_t{}))>> : std::true_type {
+};
+
+// Вместимость встроенного буфера хранилища Memory. У RawMemory встроенного буфера нет
+template <typename Memory, typename = void>
+struct InlineCapacity : std::integral_constant<size_t, 0> {
+};
+
+template <typename Memory>
+struct InlineCapacity<Memory, std::void_t<decltype(Memory::kInlineCapacity)>>
+    : std::integral_constant<size_t, Memory::kInlineCapacity> {
+};
+
+// Для std::allocator и аллокаторов без собственных construct и destroy время жизни элементов
+// можно начинать и завершать в обход allocator_traits
+template <typename T, typename Alloc>
+inline constexpr bool uses_default_construct_v = std::is_same_v<Alloc, std::allocator<T>>
+    || (!HasCustomConstruct<Alloc, T>::value && !HasCustomDestroy<Alloc, T>::value);
+
+template <typename T, typename Alloc>
+inline constexpr bool can_relocate_bitwise_v = is_trivially_relocatable_v<T> && uses_default_construct_v<T, Alloc>;
+
+// Переносит n объектов из src в неинициализированную память dest. Исходные объекты
+// после этого считаются разрушенными
+template <typename T>
+void RelocateBitwiseN(T* src, size_t n, T* dest) noexcept {
+    if (n != 0) {
+        std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), n * sizeof(T));
+    }
+}
+
+// Разрушает n элементов, начиная с first, при помощи аллокатора alloc
+template <typename Alloc, typename T>
+void DestroyN(Alloc& alloc, T* first, size_t n) noexcept {
+    for (; n > 0; --n, ++first) {
+        std::allocator_traits<Alloc>::destroy(alloc, first);
+    }
+}
+
+// Конструирует n элементов по адресу dest, вызывая construct(i) для каждого индекса.
+// Если конструирование выбросит исключение, уже созданные элементы разрушаются
+template <typename Alloc, typename T, typename Construct>
+void UninitializedConstructN(Alloc& alloc, T* dest, size_t n, Construct&& construct) {
+    size_t i = 0;
+    try {
+        for (; i < n; ++i) {
+            construct(i);
+        }
+    } catch (...) {
+        DestroyN(alloc, dest, i);
+        throw;
+    }
+}
+
+template <typename Alloc, typename T>
+void UninitializedValueConstructN(Alloc& alloc, T* dest, size_t n) {
+    UninitializedConstructN(alloc, dest, n, [&](size_t i) {
+        std::allocator_traits<Alloc>::construct(alloc, dest + i);
+    });
+}
+
+// Инициализирует элементы по умолчанию: тривиальные типы остаются неинициализированными.
+// Аллокатор с собственным construct получает обычный вызов construct без аргументов
+template <typename Alloc, typename T>
+void UninitializedDefaultConstructN(Alloc& alloc, T* dest, size_t n) {
+    if constexpr (!uses_default_construct_v<T, Alloc>) {
+        UninitializedValueConstructN(alloc, dest, n);
+    } else if constexpr (!std::is_trivially_default_constructible_v<T>) {
+        UninitializedConstructN(alloc, dest, n, [&](size_t i) {
+            ::new (static_cast<void*>(dest + i)) T;
+        });
+    }
+}
+
+template <typename T, typename Alloc>
+inline constexpr bool can_copy_bitwise_v = std::is_trivially_copyable_v<T> && uses_default_construct_v<T, Alloc>;
+
+// Копии тривиально копируемых элементов из непрерывного массива создаются одним memcpy
+template <typename Alloc, typename InputIt, typename T>
+void UninitializedCopyN(Alloc& alloc, InputIt src, size_t n, T* dest) {
+    if constexpr (std::is_pointer_v<InputIt>
+                  && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<InputIt>>, T>
+                  && can_copy_bitwise_v<T, Alloc>) {
+        if (n != 0) {
+            std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), n * sizeof(T));
+        }
+    } else {
+        UninitializedConstructN(alloc, dest, n, [&](size_t i) {
+            std::allocator_traits<Alloc>::construct(alloc, dest + i, *src);
+            ++src;
+        });
+    }
+}
+
+template <typename Alloc, typename T>
+void UninitializedMoveN(Alloc& alloc, T* src, size_t n, T* dest) {
+    UninitializedConstructN(alloc, dest, n, [&](size_t i) {
+        std::allocator_traits<Alloc>::construct(alloc, dest + i, std::move(src[i]));
+    });
+}
+
+template <typename It, typename = void>
+struct IsIterator : std::false_type {
+};
+
+template <typename It>
+struct IsIterator<It, std::void_t<typename std::iterator_traits<It>::iterator_category>> : std::true_type {
+};
+
+template <typename It>
+inline constexpr bool is_iterator_v = IsIterator<It>::value;
+
+// Признак того, что пакет Args состоит из единственной ссылки на T
+template <typename T, typename... Args>
+inline constexpr bool is_single_value_v = false;
+
+template <typename T, typename Arg>
+inline constexpr bool is_single_value_v<T, Arg> = std::is_same_v<std::remove_cv_t<std::remove_reference_t<Arg>>, T>;
+
+template <typename It>
+inline constexpr bool is_forward_iterator_v = std::is_base_of_v<std::forward_iterator_tag,
+                                                                typename std::iterator_traits<It>::iterator_category>;
+
+// Итератор, бесконечно повторяющий одно и то же значение. Позволяет выразить
+// вставку нескольких копий значения через вставку диапазона
+template <typename T>
+class RepeatIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    explicit RepeatIterator(const T& value) noexcept
+        : value_(&value) {
+    }
+
+    reference operator*() const noexcept {
+        return *value_;
+    }
+
+    RepeatIterator& operator++() noexcept {
+        return *this;
+    }
+
+    RepeatIterator operator++(int) noexcept {
+        return *this;
+    }
+
+    bool operator==(const RepeatIterator& other) const noexcept {
+        return value_ == other.value_;
+    }
+
+    bool operator!=(const RepeatIterator& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    const T* value_;
+};
+
+}  // namespace detail
+
+namespace detail {
+
+inline size_t FloorLog2(size_t value) noexcept {
+    assert(value != 0);
+#if defined(__GNUC__)
+    return sizeof(unsigned long long) * 8 - 1 - static_cast<size_t>(__builtin_clzll(value));
+#else
+    size_t result = 0;
+    while (value >>= 1) {
+        ++result;
+    }
+    return result;
+#endif
+}
+
+inline size_t SaturatingMultiply(size_t value, size_t factor) noexcept {
+    return value > std::numeric_limits<size_t>::max() / factor ? std::numeric_limits<size_t>::max() : value * factor;
+}
+
+// Минимальный объём данных, ради которого обработку стоит передавать отдельному потоку
+inline constexpr size_t kParallelChunkBytes = size_t{1} << 20;
+
+// Число частей, на которые делится обработка n элементов размера element_size.
+// Если max_threads равен 0, ограничением служит число аппаратных потоков
+inline size_t ParallelChunkCount(size_t n, size_t element_size, size_t max_threads) noexcept {
+    if (max_threads == 0) {
+        max_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return std::clamp<size_t>(SaturatingMultiply(n, element_size) / kParallelChunkBytes, 1, max_threads);
+}
+
+// Делит [0, n) на chunk_count смежных частей и вызывает chunk(first, last) для каждой в отдельном
+// потоке. Если обработка хотя бы одной части завершится исключением, для успешно обработанных частей
+// вызывается rollback(first, last), после чего первое исключение выбрасывается повторно
+template <typename Chunk, typename Rollback>
+void ParallelForChunks(size_t n, size_t chunk_count, const Chunk& chunk, const Rollback& rollback) {
+    if (chunk_count <= 1) {
+        chunk(size_t{0}, n);
+        return;
+    }
+    const auto bound = [n, chunk_count](size_t k) {
+        return n / chunk_count * k + std::min(k, n % chunk_count);
+    };
+    std::unique_ptr<std::exception_ptr[]> errors(new std::exception_ptr[chunk_count]);
+    std::unique_ptr<std::thread[]> threads(new std::thread[chunk_count - 1]);
+    const auto run = [&](size_t k) noexcept {
+        try {
+            chunk(bound(k), bound(k + 1));
+        } catch (...) {
+            errors[k] = std::current_exception();
+        }
+    };
+    for (size_t k = 1; k < chunk_count; ++k) {
+        try {
+            threads[k - 1] = std::thread(run, k);
+        } catch (...) {
+            // Не удалось запустить поток - часть обрабатывается текущим потоком
+            run(k);
+        }
+    }
+    run(0);
+    for (size_t k = 1; k < chunk_count; ++k) {
+        if (threads[k - 1].joinable()) {
+            threads[k - 1].join();
+        }
+    }
+    std::exception_ptr error;
+    for (size_t k = 0; k < chunk_count; ++k) {
+        if (errors[k] && !error) {
+            error = errors[k];
+        }
+    }
+    if (error) {
+        for (size_t k = 0; k < chunk_count; ++k) {
+            if (!errors[k]) {
+                rollback(bound(k), bound(k + 1));
+            }
+        }
+        std::rethrow_exception(error);
+    }
+}
+
+}  // namespace detail
+
+// Тег конструктора и методов, инициализирующих элементы по умолчанию вместо инициализации значением
+struct DefaultInitTag {
+    explicit DefaultInitTag() = default;
+};
+
+inline constexpr DefaultInitTag default_init{};
+
+// Тег конструкторов и методов, распределяющих инициализацию и перенос элементов между потоками.
+// Каждый поток обрабатывает не менее мегабайта элементов, поэтому небольшие векторы обрабатываются
+// в текущем потоке. Аллокатор должен допускать одновременные вызовы construct и destroy
+struct ParallelTag {
+    // max_threads ограничивает число потоков. 0 означает число аппаратных потоков
+    constexpr explicit ParallelTag(size_t max_threads = 0) noexcept
+        : max_threads(max_threads) {
+    }
+
+    size_t max_threads;
+};
+
+inline constexpr ParallelTag parallel{};
+
+// Политики роста определяют вместимость вектора при перевыделении памяти.
+// NextCapacity получает текущую вместимость, минимально необходимую вместимость
+// и размер элемента в байтах, а возвращает новую вместимость не меньше required
+
+// Удваивает вместимость. Первое выделение памяти рассчитано на InitialCapacity элементов
+template <size_t InitialCapacity = 1>
+struct DoublingGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+        return std::max({InitialCapacity, detail::SaturatingMultiply(capacity, 2), required});
+    }
+};
+
+// Увеличивает вместимость в Numerator / Denominator раз (по умолчанию в 1.5 раза). При множителе
+// меньше золотого сечения освобождённые ранее блоки со временем вмещают новый буфер и могут
+// быть переиспользованы аллокатором. Если InitialCapacity равен 0, первое выделение памяти
+// рассчитано примерно на 64 байта, но не менее чем на один элемент
+template <size_t Numerator = 3, size_t Denominator = 2, size_t InitialCapacity = 0>
+struct FactorGrowth {
+    static_assert(Numerator > Denominator && Denominator > 0, "Growth factor must be greater than 1");
+
+    static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        if (capacity == 0) {
+            const size_t initial = InitialCapacity != 0 ? InitialCapacity : std::max<size_t>(1, 64 / element_size);
+            return std::max(initial, required);
+        }
+        const size_t grown = detail::SaturatingMultiply(capacity / Denominator, Numerator)
+            + capacity % Denominator * Numerator / Denominator;
+        return std::max({grown, capacity + 1, required});
+    }
+};
+
+// Округляет вместимость, выбранную политикой BasePolicy, так, чтобы буфер целиком занимал
+// класс размера аллокатора: небольшие блоки - до степени двойки, крупные - до целых страниц
+template <typename BasePolicy = DoublingGrowth<>, size_t PageSize = 4096>
+struct SizeClassGrowth {
+    static_assert((PageSize & (PageSize - 1)) == 0, "PageSize must be a power of two");
+
+    static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t base = BasePolicy::NextCapacity(capacity, required, element_size);
+        if (base > std::numeric_limits<size_t>::max() / element_size - PageSize) {
+            return base;
+        }
+        const size_t bytes = base * element_size;
+        size_t rounded = 16;
+        if (bytes >= PageSize) {
+            rounded = (bytes + PageSize - 1) & ~(PageSize - 1);
+        } else {
+            while (rounded < bytes) {
+                rounded *= 2;
+            }
+        }
+        return std::max(base, rounded / element_size);
+    }
+};
+
+// Причины перевыделения памяти вектора
+enum class ReallocationReason {
+    Reserve,
+    Emplace,
+    Insert,
+    Shrink,
+};
+
+// Способы переноса элементов в новый буфер
+enum class RelocationKind {
+    Bitwise,
+    Move,
+    Copy,
+};
+
+// Политика статистики определяет обработчики событий, связанных с памятью вектора:
+// OnAllocate вызывается с размером каждого нового буфера в байтах, OnReallocate - с причиной
+// перевыделения, OnRelocate - со способом и количеством перенесённых элементов, OnCapacity -
+// с новой вместимостью. Политика по умолчанию ничего не делает, и вызовы исчезают при компиляции.
+// Накапливающая статистику политика VectorStats находится в vector_stats.h
+struct NoVectorStats {
+    static void OnAllocate(size_t /*bytes*/) noexcept {
+    }
+
+    static void OnReallocate(ReallocationReason /*reason*/) noexcept {
+    }
+
+    static void OnRelocate(RelocationKind /*kind*/, size_t /*count*/) noexcept {
+    }
+
+    static void OnCapacity(size_t /*capacity*/) noexcept {
+    }
+};
+
+// Политики проверки индекса в Vector::operator[]. At() проверяет индекс при любой политике
+
+// Индекс не проверяется
+struct UncheckedAccess {
+    static void CheckIndex(size_t /*index*/, size_t /*size*/) noexcept {
+    }
+};
+
+// Индекс проверяется при помощи assert и только в отладочной сборке
+struct AssertedAccess {
+    static void CheckIndex([[maybe_unused]] size_t index, [[maybe_unused]] size_t size) noexcept {
+        assert(index < size);
+    }
+};
+
+// При выходе за границы выбрасывается std::out_of_range
+struct ThrowingAccess {
+    static void CheckIndex(size_t index, size_t size) {
+        if (index >= size) {
+            throw std::out_of_range("Vector index out of range");
+        }
+    }
+};
+
+// Политики переноса элементов при перевыделении памяти. Они различаются только для типов,
+// конструктор перемещения которых может выбросить исключение, но которые можно копировать
+
+// Такие элементы копируются: если копирование прервётся исключением, вектор не изменится
+// (строгая гарантия), но перенос стоит n глубоких копий
+struct StrongRelocation {
+    static constexpr bool kMoveMayThrow = false;
+};
+
+// Элементы всегда перемещаются. Если перемещение прервётся исключением, перенесённые копии
+// разрушаются, а вектор сохраняет прежний размер, но часть его элементов остаётся в
+// допустимом, но неопределённом состоянии после перемещения (базовая гарантия)
+struct BasicRelocation {
+    static constexpr bool kMoveMayThrow = true;
+};
+
+namespace detail {
+
+// Переносит n элементов из src в неинициализированную память dest перемещением или, если
+// перемещение может выбросить исключение и RelocationPolicy требует строгой гарантии, копированием.
+// Исходные элементы не разрушаются. Возвращает выбранный способ переноса
+template <typename RelocationPolicy, typename Alloc, typename T>
+RelocationKind UninitializedMoveOrCopyN(Alloc& alloc, T* src, size_t n, T* dest) {
+    if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>
+                  || RelocationPolicy::kMoveMayThrow) {
+        UninitializedMoveN(alloc, src, n, dest);
+        return RelocationKind::Move;
+    } else {
+        UninitializedCopyN(alloc, static_cast<const T*>(src), n, dest);
+        return RelocationKind::Copy;
+    }
+}
+
+}  // namespace detail
+
+template <typename T, typename Alloc = std::allocator<T>>
+class RawMemory : private Alloc {
+    using AllocTraits = std::allocator_traits<Alloc>;
+
+    static_assert(std::is_same_v<typename AllocTraits::value_type, T>,
+                  "Alloc::value_type must be the same as T");
+
 public:
+    using allocator_type = Alloc;
+
     RawMemory() = default;
 
-    explicit RawMemory(size_t capacity)
-        : buffer_(Allocate(capacity))
+    explicit RawMemory(const Alloc& alloc) noexcept
+        : Alloc(alloc) {
+    }
+
+    explicit RawMemory(size_t capacity, const Alloc& alloc = Alloc())
+        : Alloc(alloc)
+        , buffer_(Allocate(capacity))
         , capacity_(capacity) {
     }
 
     RawMemory(const RawMemory&) = delete;
 
     RawMemory(RawMemory&& other) noexcept
-        : buffer_(std::move(other.buffer_))
-        , capacity_(std::move(other.capacity_)) {
+        : Alloc(other.GetAllocator())
+        , buffer_(std::exchange(other.buffer_, nullptr))
+        , capacity_(std::exchange(other.capacity_, 0)) {
     }
 
     RawMemory& operator=(const RawMemory& rhs) = delete;
 
     RawMemory& operator=(RawMemory&& rhs) noexcept {
-        buffer_ = std::move(rhs.buffer_);
-        capacity_ = std::move(rhs.capacity_);
-        rhs.buffer_ = nullptr;
-        rhs.capacity_ = 0;
+        if (this != &rhs) {
+            RawMemory tmp(std::move(rhs));
+            Swap(tmp);
+        }
         return *this;
     }
 
     ~RawMemory() {
-        Deallocate(buffer_);
+        Deallocate(buffer_, capacity_);
     }
 
     T* operator+(size_t offset) noexcept {
@@ -44,11 +532,13 @@ public:
     }
 
     const T* operator+(size_t offset) const noexcept {
-        return const_cast<RawMemory&>(*this) + offset;
+        assert(offset <= capacity_);
+        return buffer_ + offset;
     }
 
     const T& operator[](size_t index) const noexcept {
-        return const_cast<RawMemory&>(*this)[index];
+        assert(index < capacity_);
+        return buffer_[index];
     }
 
     T& operator[](size_t index) noexcept {
@@ -56,9 +546,12 @@ public:
         return buffer_[index];
     }
 
+    // Аллокатор обменивается вместе с буфером, так как только он может освободить эту память
     void Swap(RawMemory& other) noexcept {
-        std::swap(buffer_, other.buffer_);
-        std::swap(capacity_, other.capacity_);
+        using std::swap;
+        swap(GetAllocator(), other.GetAllocator());
+        swap(buffer_, other.buffer_);
+        swap(capacity_, other.capacity_);
     }
 
     const T* GetAddress() const noexcept {
@@ -73,66 +566,187 @@ public:
         return capacity_;
     }
 
+    // Аллокаторы с методом reallocate(p, old_n, new_n) умеют изменять размер буфера на месте
+    bool CanReallocate() const noexcept {
+        if constexpr (detail::HasReallocate<Alloc, T>::value) {
+            return buffer_ != nullptr;
+        } else {
+            return false;
+        }
+    }
+
+    // Изменяет вместимость буфера, перенося его содержимое побайтово.
+    // Допустимо только для тривиально перемещаемых элементов и при CanReallocate() == true
+    void Reallocate(size_t new_capacity) {
+        assert(CanReallocate() && new_capacity != 0);
+        if constexpr (detail::HasReallocate<Alloc, T>::value) {
+            buffer_ = GetAllocator().reallocate(buffer_, capacity_, new_capacity);
+            capacity_ = new_capacity;
+        }
+    }
+
+    const Alloc& GetAllocator() const noexcept {
+        return *this;
+    }
+
+    Alloc& GetAllocator() noexcept {
+        return *this;
+    }
+
 private:
     // Выделяет сырую память под n элементов и возвращает указатель на неё
-    static T* Allocate(size_t n) {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    T* Allocate(size_t n) {
+        return n != 0 ? AllocTraits::allocate(GetAllocator(), n) : nullptr;
     }
 
-    // Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate
-    static void Deallocate(T* buf) noexcept {
-        operator delete(buf);
+    // Освобождает сырую память под n элементов, выделенную ранее по адресу buf при помощи Allocate
+    void Deallocate(T* buf, size_t n) noexcept {
+        if (buf != nullptr) {
+            AllocTraits::deallocate(GetAllocator(), buf, n);
+        }
     }
 
     T* buffer_ = nullptr;
     size_t capacity_ = 0;
 };
 
-template <typename T>
+// Memory - хранилище элементов. Помимо RawMemory им может быть InlineMemory (см. small_vector.h),
+// которое держит первые элементы во встроенном буфере и при росте переходит на RawMemory.
+// RelocationPolicy выбирает между копированием и перемещением элементов, перемещение которых
+// может выбросить исключение (StrongRelocation или BasicRelocation)
+template <typename T, typename Alloc = std::allocator<T>, typename GrowthPolicy = DoublingGrowth<>,
+          typename Memory = RawMemory<T, Alloc>, typename StatsPolicy = NoVectorStats,
+          typename CheckPolicy = AssertedAccess, typename RelocationPolicy = StrongRelocation>
 class Vector {
+    using AllocTraits = std::allocator_traits<Alloc>;
+
+    static_assert(std::is_same_v<typename Memory::allocator_type, Alloc>, "Memory must use the same allocator");
+
+    static constexpr bool kRelocateBitwise = detail::can_relocate_bitwise_v<T, Alloc>;
+    static constexpr size_t kInlineCapacity = detail::InlineCapacity<Memory>::value;
+    static constexpr bool kNoexceptAccess = noexcept(CheckPolicy::CheckIndex(size_t{}, size_t{}));
+
 public:
 
     using iterator = T*;
     using const_iterator = const T*;
+    using allocator_type = Alloc;
+
+    Vector() noexcept(std::is_nothrow_default_constructible_v<Alloc>) = default;
+
+    explicit Vector(const Alloc& alloc) noexcept
+        : data_(alloc)
+    {
+    }
+
+    explicit Vector(size_t size, const Alloc& alloc = Alloc())
+        : data_(size, alloc)
+        , size_(size)
+    {
+        NoteInitialAllocation();
+        detail::UninitializedValueConstructN(data_.GetAllocator(), data_.GetAddress(), size);
+    }
 
-    Vector() noexcept = default;
+    // Создаёт вектор из size элементов, инициализированных по умолчанию.
+    // Элементы тривиальных типов остаются неинициализированными
+    Vector(size_t size, DefaultInitTag, const Alloc& alloc = Alloc())
+        : data_(size, alloc)
+        , size_(size)
+    {
+        NoteInitialAllocation();
+        detail::UninitializedDefaultConstructN(data_.GetAllocator(), data_.GetAddress(), size);
+    }
 
-    explicit Vector(size_t size)
-        : data_(size)
+    // Создаёт вектор из size элементов, инициализированных значением, в нескольких потоках
+    Vector(size_t size, ParallelTag policy, const Alloc& alloc = Alloc())
+        : data_(size, alloc)
         , size_(size)
     {
-        std::uninitialized_value_construct_n(data_.GetAddress(), size);
+        NoteInitialAllocation();
+        ParallelConstruct(data_.GetAddress(), size, policy, [this](T* dest, size_t n) {
+            detail::UninitializedValueConstructN(data_.GetAllocator(), dest, n);
+        });
+    }
+
+    template <typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+    Vector(InputIt first, InputIt last, const Alloc& alloc = Alloc())
+        : data_(alloc)
+    {
+        try {
+            Append(first, last);
+        } catch (...) {
+            detail::DestroyN(data_.GetAllocator(), data_.GetAddress(), size_);
+            throw;
+        }
     }
 
     Vector(const Vector& other)
-        : data_(other.size_)
+        : Vector(other, AllocTraits::select_on_container_copy_construction(other.GetAllocator()))
+    {
+    }
+
+    Vector(const Vector& other, const Alloc& alloc)
+        : data_(other.size_, alloc)
+        , size_(other.size_)
+    {
+        NoteInitialAllocation();
+        detail::UninitializedCopyN(data_.GetAllocator(), other.data_.GetAddress(), other.size_, data_.GetAddress());
+    }
+
+    // Копирует other в нескольких потоках
+    Vector(const Vector& other, ParallelTag policy)
+        : data_(other.size_, AllocTraits::select_on_container_copy_construction(other.GetAllocator()))
         , size_(other.size_)
     {
-        std::uninitialized_copy_n(other.data_.GetAddress(), other.size_, data_.GetAddress());
+        NoteInitialAllocation();
+        const T* src = other.data_.GetAddress();
+        T* dest = data_.GetAddress();
+        ParallelConstruct(dest, size_, policy, [this, src, dest](T* chunk, size_t n) {
+            detail::UninitializedCopyN(data_.GetAllocator(), src + (chunk - dest), n, chunk);
+        });
     }
 
-    Vector(Vector&& other) noexcept {
-        Swap(other);
+    Vector(Vector&& other) noexcept(kInlineCapacity == 0 || kRelocateBitwise || std::is_nothrow_move_constructible_v<T>)
+        : data_(std::move(other.data_))
+        , size_(std::exchange(other.size_, 0))
+    {
+        if constexpr (kInlineCapacity > 0) {
+            if (data_.IsInline()) {
+                // Элементы из встроенного буфера other нельзя забрать вместе с памятью
+                other.size_ = std::exchange(size_, 0);
+                TakeInlineElements(other);
+            }
+        }
     }
 
     Vector& operator=(const Vector& rhs) {
         if (this != &rhs) {
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+                if (GetAllocator() != rhs.GetAllocator()) {
+                    // Собственной памятью может распорядиться только собственный аллокатор,
+                    // поэтому копия целиком строится аллокатором rhs
+                    Vector rhs_copy(rhs, rhs.GetAllocator());
+                    Swap(rhs_copy);
+                    return *this;
+                }
+            }
             if (rhs.size_ > data_.Capacity()) {
-                Vector rhs_copy(rhs);
+                Vector rhs_copy(rhs, GetAllocator());
                 Swap(rhs_copy);
             } else {
-                if (rhs.size_ < size_) {
-                    size_t i = 0;
-                    for (; i < rhs.size_; ++i) {
-                        data_[i] = rhs.data_[i];
+                const T* src = rhs.data_.GetAddress();
+                T* dest = data_.GetAddress();
+                if constexpr (detail::can_copy_bitwise_v<T, Alloc>) {
+                    // Присваивание существующим элементам и конструирование новых - одно копирование
+                    if (rhs.size_ != 0) {
+                        std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), rhs.size_ * sizeof(T));
                     }
-                    std::destroy_n(data_ + i, size_ - rhs.size_);
+                } else if (rhs.size_ < size_) {
+                    std::copy_n(src, rhs.size_, dest);
+                    detail::DestroyN(data_.GetAllocator(), dest + rhs.size_, size_ - rhs.size_);
                 } else {
-                    size_t i = 0;
-                    for (; i < size_; ++i) {
-                        data_[i] = rhs.data_[i];
-                    }
-                    std::uninitialized_copy_n(rhs.data_ + i, rhs.size_ - size_, data_ + i);
+                    std::copy_n(src, size_, dest);
+                    detail::UninitializedCopyN(data_.GetAllocator(), src + size_, rhs.size_ - size_, dest + size_);
                 }
                 size_ = rhs.size_;
             }
@@ -140,8 +754,18 @@ public:
         return *this;
     }
 
-    Vector& operator=(Vector&& rhs) noexcept {
-        Swap(rhs);
+    // Аллокатор перемещается вместе с буфером rhs
+    Vector& operator=(Vector&& rhs) noexcept(kInlineCapacity == 0 || kRelocateBitwise
+                                             || std::is_nothrow_move_constructible_v<T>) {
+        if constexpr (kInlineCapacity == 0) {
+            Swap(rhs);
+        } else if (this != &rhs) {
+            detail::DestroyN(data_.GetAllocator(), data_.GetAddress(), size_);
+            size_ = 0;
+            RawMemory<T, Alloc> old_data(data_.GetAllocator());
+            data_.Swap(old_data);
+            TakeElements(rhs);
+        }
         return *this;
     }
 
@@ -149,30 +773,112 @@ public:
         if (new_capacity <= data_.Capacity()) {
             return;
         }
-        RawMemory<T> new_data(new_capacity);
+        Reallocate(new_capacity, ReallocationReason::Reserve);
+    }
 
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-            std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
+    // Аналог Reserve, переносящий элементы в нескольких потоках
+    void Reserve(size_t new_capacity, ParallelTag policy) {
+        if (new_capacity <= data_.Capacity()) {
+            return;
+        }
+        if constexpr (kRelocateBitwise) {
+            if (data_.CanReallocate()) {
+                ReallocateInPlace(new_capacity, ReallocationReason::Reserve);
+                return;
+            }
+        }
+        RawMemory<T, Alloc> new_data = AllocateMemory(new_capacity, ReallocationReason::Reserve);
+        T* src = data_.GetAddress();
+        T* dest = new_data.GetAddress();
+        if constexpr (kRelocateBitwise) {
+            detail::ParallelForChunks(size_, detail::ParallelChunkCount(size_, sizeof(T), policy.max_threads),
+                                      [src, dest](size_t first, size_t last) {
+                                          detail::RelocateBitwiseN(src + first, last - first, dest + first);
+                                      },
+                                      [](size_t, size_t) {
+                                      });
+            StatsPolicy::OnRelocate(RelocationKind::Bitwise, size_);
         } else {
-            std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+            ParallelConstruct(dest, size_, policy, [this, src, dest](T* chunk, size_t n) {
+                UninitializedMoveOrCopy(src + (chunk - dest), n, chunk);
+            });
+            detail::DestroyN(data_.GetAllocator(), src, size_);
         }
-        std::destroy_n(data_.GetAddress(), size_);
-
         data_.Swap(new_data);
     }
 
-    void Resize(size_t new_size) {
-        if(new_size == size_) {
+    // Уменьшает вместимость до max(new_capacity, Size()), перенося элементы так же, как Reserve
+    void ShrinkTo(size_t new_capacity) {
+        new_capacity = std::max(new_capacity, size_);
+        if (new_capacity >= data_.Capacity()) {
             return;
         }
+        if constexpr (kInlineCapacity > 0) {
+            if (data_.IsInline()) {
+                return;
+            }
+            if (new_capacity <= kInlineCapacity) {
+                // Элементы возвращаются во встроенный буфер, а динамическая память освобождается
+                Relocate(data_.GetAddress(), size_, data_.InlineAddress());
+                RawMemory<T, Alloc> old_data(data_.GetAllocator());
+                data_.Swap(old_data);
+                StatsPolicy::OnReallocate(ReallocationReason::Shrink);
+                return;
+            }
+        }
+        Reallocate(new_capacity, ReallocationReason::Shrink);
+    }
 
-        if(new_size < size_) {
-            std::destroy_n(data_ + new_size, size_ - new_size);
-        } else {
-            Reserve(new_size);
-            std::uninitialized_value_construct_n(data_ + size_, new_size - size_);
+    void ShrinkToFit() {
+        ShrinkTo(size_);
+    }
+
+    // Разрушает все элементы, сохраняя вместимость
+    void Clear() noexcept {
+        detail::DestroyN(data_.GetAllocator(), data_.GetAddress(), size_);
+        size_ = 0;
+    }
+
+    void Resize(size_t new_size) {
+        ResizeWith(new_size, [this](T* dest, size_t n) {
+            detail::UninitializedValueConstructN(data_.GetAllocator(), dest, n);
+        });
+    }
+
+    // Аналог Resize, инициализирующий новые элементы и переносящий существующие в нескольких потоках
+    void Resize(size_t new_size, ParallelTag policy) {
+        Reserve(new_size, policy);
+        ResizeWith(new_size, [this, policy](T* dest, size_t n) {
+            ParallelConstruct(dest, n, policy, [this](T* chunk, size_t chunk_size) {
+                detail::UninitializedValueConstructN(data_.GetAllocator(), chunk, chunk_size);
+            });
+        });
+    }
+
+    // Изменяет размер, инициализируя новые элементы по умолчанию, а не значением.
+    // Подходит для буферов, которые сразу же будут перезаписаны
+    void ResizeDefaultInit(size_t new_size) {
+        ResizeWith(new_size, [this](T* dest, size_t n) {
+            detail::UninitializedDefaultConstructN(data_.GetAllocator(), dest, n);
+        });
+    }
+
+    // Аналог std::string::resize_and_overwrite: делает размер равным count, инициализируя новые
+    // элементы по умолчанию, и вызывает op(data, count). op заполняет буфер и возвращает итоговый
+    // размер, не превышающий count. Элементы за итоговым размером разрушаются
+    template <typename Operation>
+    void ResizeAndOverwrite(size_t count, Operation op) {
+        const size_t old_size = size_;
+        ResizeDefaultInit(count);
+        size_t new_size = 0;
+        try {
+            new_size = static_cast<size_t>(op(data_.GetAddress(), count));
+        } catch (...) {
+            Resize(std::min(old_size, count));
+            throw;
         }
-        size_ = new_size;
+        assert(new_size <= count);
+        Resize(new_size);
     }
 
 
@@ -181,7 +887,7 @@ public:
     }
 
     iterator end() noexcept {
-        return data_ + size_;
+        return data_.GetAddress() + size_;
     }
 
     const_iterator begin() const noexcept {
@@ -189,7 +895,7 @@ public:
     }
 
     const_iterator end() const noexcept {
-        return data_ + size_;
+        return data_.GetAddress() + size_;
     }
 
     const_iterator cbegin() const noexcept {
@@ -208,15 +914,27 @@ public:
             return EmplaceRealloc(pos, std::forward<Args>(args)...);
 
         if(position == end()) {
-            new (position) T(std::forward<Args>(args)...);
+            AllocTraits::construct(data_.GetAllocator(), position, std::forward<Args>(args)...);
             ++size_;
             return position;
         }
 
-        T tmp(std::forward<Args>(args)...);
-        std::uninitialized_move_n(end() - 1, 1, end());
-        std::move_backward(position, end() - 1, end());
-        *position = std::move(tmp);
+        if constexpr (detail::is_single_value_v<T, Args...>) {
+            EmplaceValueInPlace(position, std::forward<Args>(args)...);
+        } else if constexpr (kRelocateBitwise) {
+            // Аргументы могут ссылаться на элементы хвоста, поэтому объект создаётся до сдвига,
+            // а затем переносится в освободившуюся ячейку побайтово
+            alignas(T) unsigned char storage[sizeof(T)];
+            T* tmp = ::new (static_cast<void*>(storage)) T(std::forward<Args>(args)...);
+            std::memmove(static_cast<void*>(position + 1), static_cast<const void*>(position),
+                         (end() - position) * sizeof(T));
+            detail::RelocateBitwiseN(tmp, 1, position);
+        } else {
+            T tmp(std::forward<Args>(args)...);
+            AllocTraits::construct(data_.GetAllocator(), end(), std::move(*(end() - 1)));
+            std::move_backward(position, end() - 1, end());
+            *position = std::move(tmp);
+        }
         ++size_;
         return position;
     }
@@ -229,32 +947,123 @@ public:
         return Emplace(pos, std::forward<T&>(const_cast<T&>(value)));
     }
 
+    // Вставляет count копий value перед pos, выполняя не более одного перевыделения памяти
+    iterator Insert(const_iterator pos, size_t count, const T& value) {
+        const size_t index = pos - cbegin();
+        const std::less<const T*> less;
+        if (!less(&value, cbegin()) && less(&value, cend())) {
+            // value ссылается на элемент вектора, который будет сдвинут или перенесён
+            const T value_copy(value);
+            return InsertRange(index, detail::RepeatIterator<T>(value_copy), count);
+        }
+        return InsertRange(index, detail::RepeatIterator<T>(value), count);
+    }
+
+    // Вставляет элементы диапазона [first, last) перед pos. Для многопроходных итераторов
+    // итоговый размер вычисляется заранее, поэтому память перевыделяется не более одного раза,
+    // а хвост сдвигается единожды. Диапазон не должен ссылаться на элементы самого вектора
+    template <typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+    iterator Insert(const_iterator pos, InputIt first, InputIt last) {
+        const size_t index = pos - cbegin();
+        if constexpr (detail::is_forward_iterator_v<InputIt>) {
+            return InsertRange(index, first, static_cast<size_t>(std::distance(first, last)));
+        } else if (index == size_) {
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+            return begin() + index;
+        } else {
+            // Длина однопроходного диапазона неизвестна, пока он не прочитан целиком
+            Vector buffer(first, last, GetAllocator());
+            return InsertRange(index, std::make_move_iterator(buffer.begin()), buffer.Size());
+        }
+    }
+
+    template <typename InputIt, typename = std::enable_if_t<detail::is_iterator_v<InputIt>>>
+    void Append(InputIt first, InputIt last) {
+        Insert(cend(), first, last);
+    }
+
+    template <typename Range>
+    void Append(const Range& range) {
+        using std::begin;
+        using std::end;
+        Append(begin(range), end(range));
+    }
+
+    // При свободной вместимости сводится к конструированию элемента и увеличению размера.
+    // Перевыделение памяти вынесено в отдельную невстраиваемую функцию, чтобы не раздувать
+    // горячий путь в местах вызова
     template <typename... Args>
     T& EmplaceBack(Args&&... args) {
-        return *Emplace(end(), std::forward<Args>(args)...);
+        if (VECTOR_UNLIKELY(size_ == data_.Capacity())) {
+            return GrowAndEmplaceBack(std::forward<Args>(args)...);
+        }
+        T* slot = data_.GetAddress() + size_;
+        AllocTraits::construct(data_.GetAllocator(), slot, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
     }
 
     void PushBack(T&& value) {
-        EmplaceBack(std::forward<T>(value));
+        EmplaceBack(std::move(value));
     }
 
     void PushBack(const T& value) {
-        EmplaceBack(std::forward<T&>(const_cast<T&>(value)));
+        EmplaceBack(value);
     }
 
     void PopBack() noexcept {
         assert(size_ > 0);
-        std::destroy_n(end() - 1, 1);
+        AllocTraits::destroy(data_.GetAllocator(), end() - 1);
         --size_;
     }
 
     iterator Erase(const_iterator pos) {
+        return Erase(pos, pos + 1);
+    }
+
+    // Удаляет элементы [first, last), сдвигая хвост вектора однократно
+    iterator Erase(const_iterator first, const_iterator last) {
+        auto position = const_cast<T*>(first);
+        const size_t count = last - first;
+        if (count == 0) {
+            return position;
+        }
+
+        if constexpr (kRelocateBitwise) {
+            detail::DestroyN(data_.GetAllocator(), position, count);
+            std::memmove(static_cast<void*>(position), static_cast<const void*>(position + count),
+                         (end() - (position + count)) * sizeof(T));
+        } else {
+            auto new_end = std::move(position + count, end(), position);
+            detail::DestroyN(data_.GetAllocator(), new_end, count);
+        }
+        size_ -= count;
+        return position;
+    }
+
+    // Удаляет элемент pos за O(1), перемещая на его место последний элемент.
+    // Порядок оставшихся элементов не сохраняется
+    iterator SwapErase(const_iterator pos) {
         auto position = const_cast<T*>(pos);
-        std::move(position + 1, end(), position);
+        assert(position < end());
+        if (position != end() - 1) {
+            *position = std::move(*(end() - 1));
+        }
         PopBack();
         return position;
     }
 
+    // Удаляет за один проход все элементы, удовлетворяющие pred, и возвращает их количество
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred) {
+        auto new_end = std::remove_if(begin(), end(), pred);
+        const size_t count = end() - new_end;
+        Erase(new_end, end());
+        return count;
+    }
+
     size_t Size() const noexcept {
         return size_;
     }
@@ -263,65 +1072,361 @@ public:
         return data_.Capacity();
     }
 
-    const T& operator[](size_t index) const noexcept {
-        return const_cast<Vector&>(*this)[index];
+    allocator_type GetAllocator() const noexcept {
+        return data_.GetAllocator();
     }
 
-    T& operator[](size_t index) noexcept {
-        assert(index < size_);
-        return data_[index];
+    const T& operator[](size_t index) const noexcept(kNoexceptAccess) {
+        CheckPolicy::CheckIndex(index, size_);
+        return data_.GetAddress()[index];
+    }
+
+    T& operator[](size_t index) noexcept(kNoexceptAccess) {
+        CheckPolicy::CheckIndex(index, size_);
+        return data_.GetAddress()[index];
+    }
+
+    // Доступ с проверкой индекса, выбрасывающий std::out_of_range независимо от CheckPolicy
+    const T& At(size_t index) const {
+        ThrowingAccess::CheckIndex(index, size_);
+        return data_.GetAddress()[index];
+    }
+
+    T& At(size_t index) {
+        ThrowingAccess::CheckIndex(index, size_);
+        return data_.GetAddress()[index];
+    }
+
+    // Указатель на первый элемент для циклов, которым не нужны проверки индексов
+    const T* Data() const noexcept {
+        return data_.GetAddress();
+    }
+
+    T* Data() noexcept {
+        return data_.GetAddress();
+    }
+
+    Span<const T> AsSpan() const noexcept {
+        return {data_.GetAddress(), size_};
     }
 
-    void Swap(Vector& other) noexcept {
-        std::swap(data_, other.data_);
-        std::swap(size_, other.size_);
+    Span<T> AsSpan() noexcept {
+        return {data_.GetAddress(), size_};
+    }
+
+    void Swap(Vector& other) noexcept(kInlineCapacity == 0 || kRelocateBitwise || std::is_nothrow_move_constructible_v<T>) {
+        if constexpr (kInlineCapacity == 0) {
+            data_.Swap(other.data_);
+            std::swap(size_, other.size_);
+        } else if (!data_.IsInline() && !other.data_.IsInline()) {
+            data_.Swap(other.data_);
+            std::swap(size_, other.size_);
+        } else if (this != &other) {
+            Vector tmp(std::move(other));
+            other.TakeElements(*this);
+            TakeElements(tmp);
+        }
     }
 
     ~Vector() {
-        std::destroy_n(data_.GetAddress(), size_);
+        detail::DestroyN(data_.GetAllocator(), data_.GetAddress(), size_);
     }
 
 private:
-    void UninitializedMoveOrCopy(iterator begin, iterator end, iterator dest){
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-            std::uninitialized_move(begin, end, dest);
+    void Reallocate(size_t new_capacity, ReallocationReason reason) {
+        if constexpr (kRelocateBitwise) {
+            if (data_.CanReallocate() && new_capacity != 0) {
+                ReallocateInPlace(new_capacity, reason);
+                return;
+            }
+        }
+        RawMemory<T, Alloc> new_data = AllocateMemory(new_capacity, reason);
+        Relocate(data_.GetAddress(), size_, new_data.GetAddress());
+        data_.Swap(new_data);
+    }
+
+    // Выделяет новый буфер, сообщая о нём политике статистики
+    RawMemory<T, Alloc> AllocateMemory(size_t capacity, ReallocationReason reason) {
+        RawMemory<T, Alloc> memory(capacity, data_.GetAllocator());
+        StatsPolicy::OnReallocate(reason);
+        NoteAllocation(capacity);
+        return memory;
+    }
+
+    // Изменяет вместимость буфера на месте средствами аллокатора
+    void ReallocateInPlace(size_t new_capacity, ReallocationReason reason) {
+        data_.Reallocate(new_capacity);
+        StatsPolicy::OnReallocate(reason);
+        NoteAllocation(new_capacity);
+    }
+
+    void NoteAllocation(size_t capacity) noexcept {
+        if (capacity != 0) {
+            StatsPolicy::OnAllocate(capacity * sizeof(T));
+            StatsPolicy::OnCapacity(capacity);
+        }
+    }
+
+    // Учитывает буфер, выделенный при конструировании вектора
+    void NoteInitialAllocation() noexcept {
+        if constexpr (kInlineCapacity > 0) {
+            if (data_.IsInline()) {
+                return;
+            }
+        }
+        NoteAllocation(data_.Capacity());
+    }
+
+    // Конструирует n элементов по адресу dest частями в нескольких потоках, вызывая construct(chunk, count)
+    // для каждой части. construct сам разрушает созданные им элементы при исключении, а при ошибке
+    // в любой из частей разрушаются и все остальные части
+    template <typename Construct>
+    void ParallelConstruct(T* dest, size_t n, ParallelTag policy, const Construct& construct) {
+        detail::ParallelForChunks(n, detail::ParallelChunkCount(n, sizeof(T), policy.max_threads),
+                                  [dest, &construct](size_t first, size_t last) {
+                                      construct(dest + first, last - first);
+                                  },
+                                  [this, dest](size_t first, size_t last) {
+                                      detail::DestroyN(data_.GetAllocator(), dest + first, last - first);
+                                  });
+    }
+
+    template <typename Construct>
+    void ResizeWith(size_t new_size, Construct&& construct) {
+        if(new_size == size_) {
+            return;
+        }
+
+        if(new_size < size_) {
+            detail::DestroyN(data_.GetAllocator(), data_ + new_size, size_ - new_size);
         } else {
-            std::uninitialized_copy(begin, end, dest);
+            Reserve(new_size);
+            construct(data_ + size_, new_size - size_);
         }
+        size_ = new_size;
+    }
+
+    // Переносит n элементов из src в неинициализированную память dest и разрушает исходные.
+    // Если перенос прервётся исключением, исходные элементы остаются на месте: нетронутыми
+    // или, при BasicRelocation, частично перемещёнными
+    void Relocate(T* src, size_t n, T* dest) {
+        if constexpr (kRelocateBitwise) {
+            detail::RelocateBitwiseN(src, n, dest);
+            StatsPolicy::OnRelocate(RelocationKind::Bitwise, n);
+        } else {
+            UninitializedMoveOrCopy(src, n, dest);
+            detail::DestroyN(data_.GetAllocator(), src, n);
+        }
+    }
+
+    // Забирает элементы other, который находится во встроенном буфере, в собственный встроенный буфер
+    void TakeInlineElements(Vector& other) {
+        Relocate(other.data_.InlineAddress(), other.size_, data_.InlineAddress());
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    // Забирает элементы other. Вектор должен быть пуст и не владеть динамической памятью
+    void TakeElements(Vector& other) {
+        assert(size_ == 0 && data_.IsInline());
+        if (other.data_.IsInline()) {
+            TakeInlineElements(other);
+        } else {
+            data_.Swap(other.data_);
+            size_ = std::exchange(other.size_, 0);
+        }
+    }
+
+    void UninitializedMoveOrCopy(T* src, size_t n, T* dest) {
+        const RelocationKind kind = detail::UninitializedMoveOrCopyN<RelocationPolicy>(data_.GetAllocator(), src, n, dest);
+        StatsPolicy::OnRelocate(kind, n);
+    }
+
+    // Вставляет value перед position при свободной вместимости без временного объекта: элемент
+    // присваивается или конструируется прямо из value. Если value ссылается на элемент хвоста,
+    // после сдвига этот элемент находится на одну позицию правее
+    template <typename Value>
+    void EmplaceValueInPlace(T* position, Value&& value) {
+        using Pointer = std::remove_reference_t<Value>*;
+        Pointer source = std::addressof(value);
+        const std::less<const T*> less;
+        if (!less(source, position) && less(source, end())) {
+            ++source;
+        }
+        const size_t tail = end() - position;
+        if constexpr (kRelocateBitwise) {
+            std::memmove(static_cast<void*>(position + 1), static_cast<const void*>(position), tail * sizeof(T));
+            try {
+                AllocTraits::construct(data_.GetAllocator(), position, static_cast<Value&&>(*source));
+            } catch (...) {
+                std::memmove(static_cast<void*>(position), static_cast<const void*>(position + 1), tail * sizeof(T));
+                throw;
+            }
+        } else {
+            AllocTraits::construct(data_.GetAllocator(), end(), std::move(*(end() - 1)));
+            std::move_backward(position, end() - 1, end());
+            *position = static_cast<Value&&>(*source);
+        }
+    }
+
+    template <typename... Args>
+    VECTOR_NOINLINE T& GrowAndEmplaceBack(Args&&... args) {
+        return *EmplaceRealloc(cend(), std::forward<Args>(args)...);
     }
 
     template <typename... Args>
     iterator EmplaceRealloc(const_iterator pos, Args&&... args) {
-        size_t new_capacity = size_ == 0 ? 1 : size_ * 2;
-        RawMemory<T> new_data(new_capacity);
+        const size_t new_capacity = GrowthPolicy::NextCapacity(Capacity(), size_ + 1, sizeof(T));
+        const size_t index = pos - cbegin();
+        if constexpr (kRelocateBitwise) {
+            if (data_.CanReallocate()) {
+                return EmplaceReallocInPlace(index, new_capacity, std::forward<Args>(args)...);
+            }
+        }
+        return InsertRealloc(index, 1, new_capacity, ReallocationReason::Emplace, [&](T* dest) {
+            AllocTraits::construct(data_.GetAllocator(), dest, std::forward<Args>(args)...);
+        });
+    }
 
-        auto position = const_cast<T*>(pos);
+    // Выделяет буфер вместимостью new_capacity, создаёт в нём count новых элементов с индекса index
+    // при помощи construct(dest) и переносит вокруг них существующие элементы. Новые элементы
+    // создаются до переноса, так как их источник может ссылаться на элементы вектора
+    template <typename Construct>
+    iterator InsertRealloc(size_t index, size_t count, size_t new_capacity, ReallocationReason reason,
+                           Construct&& construct) {
+        RawMemory<T, Alloc> new_data = AllocateMemory(new_capacity, reason);
+
+        auto position = begin() + index;
         auto new_begin = new_data.GetAddress();
-        auto new_position = new_data + (pos - cbegin());
+        auto new_position = new_begin + index;
 
-        int step = 0;
-        try {
-            new (new_position) T(std::forward<Args>(args)...);
-            ++step; // 1
-            UninitializedMoveOrCopy(begin(), position, new_begin);
-            ++step; // 2
-            UninitializedMoveOrCopy(position, end(), new_position + 1);
-            std::destroy_n(begin(), size_);
-            data_.Swap(new_data);
-        }  catch (...) {
-            if(step == 1) {
-                std::destroy_n(new_position, 1);
-            } else
-            if(step == 2) {
-                std::destroy(new_begin, new_position + 1);
+        construct(new_position);
+        if constexpr (kRelocateBitwise) {
+            detail::RelocateBitwiseN(begin(), index, new_begin);
+            detail::RelocateBitwiseN(position, size_ - index, new_position + count);
+            StatsPolicy::OnRelocate(RelocationKind::Bitwise, size_);
+        } else {
+            int step = 0;
+            try {
+                UninitializedMoveOrCopy(begin(), index, new_begin);
+                ++step; // 1
+                UninitializedMoveOrCopy(position, size_ - index, new_position + count);
+            }  catch (...) {
+                if(step == 0) {
+                    detail::DestroyN(data_.GetAllocator(), new_position, count);
+                } else {
+                    detail::DestroyN(data_.GetAllocator(), new_begin, index + count);
+                }
+                throw;
+            }
+            detail::DestroyN(data_.GetAllocator(), begin(), size_);
+        }
+
+        data_.Swap(new_data);
+        size_ += count;
+        return new_position;
+    }
+
+    // Вставляет count элементов, последовательно читаемых из first, начиная с индекса index
+    template <typename ForwardIt>
+    iterator InsertRange(size_t index, ForwardIt first, size_t count) {
+        if (count == 0) {
+            return begin() + index;
+        }
+        if (count > Capacity() - size_) {
+            const size_t new_capacity = GrowthPolicy::NextCapacity(Capacity(), size_ + count, sizeof(T));
+            bool reallocated = false;
+            if constexpr (kRelocateBitwise) {
+                if (data_.CanReallocate()) {
+                    ReallocateInPlace(new_capacity, ReallocationReason::Insert);
+                    reallocated = true;
+                }
+            }
+            if (!reallocated) {
+                return InsertRealloc(index, count, new_capacity, ReallocationReason::Insert, [&](T* dest) {
+                    detail::UninitializedCopyN(data_.GetAllocator(), first, count, dest);
+                });
+            }
+        }
+
+        Alloc& alloc = data_.GetAllocator();
+        auto position = begin() + index;
+        auto old_end = end();
+        const size_t tail = size_ - index;
+
+        if constexpr (kRelocateBitwise) {
+            std::memmove(static_cast<void*>(position + count), static_cast<const void*>(position), tail * sizeof(T));
+            try {
+                detail::UninitializedCopyN(alloc, first, count, position);
+            } catch (...) {
+                std::memmove(static_cast<void*>(position), static_cast<const void*>(position + count), tail * sizeof(T));
+                throw;
+            }
+        } else if (count <= tail) {
+            // Последние count элементов хвоста переезжают в неинициализированную память,
+            // остальные сдвигаются присваиванием
+            detail::UninitializedMoveN(alloc, old_end - count, count, old_end);
+            size_ += count;
+            std::move_backward(position, old_end - count, old_end);
+            std::copy_n(first, count, position);
+            return position;
+        } else {
+            // Часть вставляемых элементов попадает за прежний конец вектора
+            ForwardIt middle = std::next(first, tail);
+            detail::UninitializedCopyN(alloc, middle, count - tail, old_end);
+            try {
+                detail::UninitializedMoveN(alloc, position, tail, old_end + (count - tail));
+            } catch (...) {
+                detail::DestroyN(alloc, old_end, count - tail);
+                throw;
             }
+            size_ += count;
+            std::copy_n(first, tail, position);
+            return position;
+        }
+        size_ += count;
+        return position;
+    }
+
+    // Расширяет буфер на месте и раздвигает элементы, освобождая ячейку index
+    template <typename... Args>
+    iterator EmplaceReallocInPlace(size_t index, size_t new_capacity, Args&&... args) {
+        // Аргументы могут ссылаться на элементы вектора, которые станут недоступны
+        // после перевыделения, поэтому новый элемент сначала создаётся во временной памяти
+        alignas(T) unsigned char storage[sizeof(T)];
+        T* value = reinterpret_cast<T*>(storage);
+        AllocTraits::construct(data_.GetAllocator(), value, std::forward<Args>(args)...);
+        try {
+            ReallocateInPlace(new_capacity, ReallocationReason::Emplace);
+        } catch (...) {
+            AllocTraits::destroy(data_.GetAllocator(), value);
             throw;
         }
 
+        T* position = begin() + index;
+        std::memmove(static_cast<void*>(position + 1), static_cast<const void*>(position), (size_ - index) * sizeof(T));
+        detail::RelocateBitwiseN(value, 1, position);
         ++size_;
-        return new_position;
+        return position;
     }
 
-    RawMemory<T> data_;
+    Memory data_;
     size_t size_ = 0;
 };
+
+// Для скалярных типов std::equal сводится к memcmp. Векторизованное сравнение
+// чисел с плавающей точкой находится в vector_algorithms.h
+template <typename T, typename... Params>
+bool operator==(const Vector<T, Params...>& lhs, const Vector<T, Params...>& rhs) {
+    return lhs.Size() == rhs.Size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename... Params>
+bool operator!=(const Vector<T, Params...>& lhs, const Vector<T, Params...>& rhs) {
+    return !(lhs == rhs);
+}
+
+// Vector с BasicRelocation и остальными политиками по умолчанию: элементы с выбрасывающим
+// перемещением переносятся перемещением, а не копированием
+template <typename T, typename Alloc = std::allocator<T>, typename GrowthPolicy = DoublingGrowth<>>
+using BasicRelocationVector = Vector<T, Alloc, GrowthPolicy, RawMemory<T, Alloc>, NoVectorStats, AssertedAccess,
+                                     BasicRelocation>;
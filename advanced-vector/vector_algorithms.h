@@ -0,0 +1,435 @@
+#pragma once
+#include "span.h"
+#include "vector.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+// Векторизованные алгоритмы над непрерывными массивами арифметических типов. Ядра написаны на
+// векторных расширениях GCC и Clang и компилируются в нескольких вариантах: для x86 с AVX-512 и AVX2,
+// которые выбираются во время выполнения по возможностям процессора, и базовый вариант со 128-битными
+// векторами (SSE2 на x86-64, NEON на AArch64). Другие компиляторы получают скалярные циклы.
+// Алгоритмы принимают Span, а перегрузки для Vector обращаются к его AsSpan()
+
+namespace detail {
+
+template <typename T>
+struct TypeIdentity {
+    using type = T;
+};
+
+template <typename T>
+using TypeIdentityT = typename TypeIdentity<T>::type;
+
+template <typename T>
+inline constexpr bool is_simd_arithmetic_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+// Тип результата Sum: целые числа суммируются в 64 битах, числа с плавающей точкой - в собственном типе
+template <typename T>
+using SumType = std::conditional_t<std::is_floating_point_v<T>, T,
+                                   std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+}  // namespace detail
+
+namespace detail::simd {
+
+#if defined(__GNUC__)
+
+// Векторы передаются только между встраиваемыми функциями, поэтому различия ABI для них не важны
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+#define VECTOR_SIMD_INLINE inline __attribute__((always_inline))
+
+template <typename T, size_t Width>
+struct Lanes {
+    typedef T type __attribute__((vector_size(Width)));
+};
+
+template <typename T, size_t Width>
+using LanesT = typename Lanes<T, Width>::type;
+
+template <typename V>
+VECTOR_SIMD_INLINE V Load(const void* p) noexcept {
+    V v;
+    std::memcpy(&v, p, sizeof(V));
+    return v;
+}
+
+template <typename V>
+VECTOR_SIMD_INLINE void Store(void* p, const V& v) noexcept {
+    std::memcpy(p, &v, sizeof(V));
+}
+
+// Проверяет, есть ли в маске сравнения хотя бы одна установленная дорожка
+template <typename Mask>
+VECTOR_SIMD_INLINE bool Any(const Mask& mask) noexcept {
+    uint64_t words[sizeof(Mask) / sizeof(uint64_t)];
+    std::memcpy(words, &mask, sizeof(Mask));
+    uint64_t any = 0;
+    for (uint64_t word : words) {
+        any |= word;
+    }
+    return any != 0;
+}
+
+template <typename Mask>
+VECTOR_SIMD_INLINE bool All(const Mask& mask) noexcept {
+    uint64_t words[sizeof(Mask) / sizeof(uint64_t)];
+    std::memcpy(words, &mask, sizeof(Mask));
+    uint64_t all = ~uint64_t{0};
+    for (uint64_t word : words) {
+        all &= word;
+    }
+    return all == ~uint64_t{0};
+}
+
+struct FillKernel {
+    template <size_t Width, typename T>
+    static VECTOR_SIMD_INLINE int Run(T* data, size_t n, T value) noexcept {
+        using V = LanesT<T, Width>;
+        constexpr size_t kLanes = Width / sizeof(T);
+        const V broadcast = V{} + value;
+        size_t i = 0;
+        for (; i + kLanes <= n; i += kLanes) {
+            Store(data + i, broadcast);
+        }
+        for (; i < n; ++i) {
+            data[i] = value;
+        }
+        return 0;
+    }
+};
+
+struct FindKernel {
+    template <size_t Width, typename T>
+    static VECTOR_SIMD_INLINE size_t Run(const T* data, size_t n, T value) noexcept {
+        using V = LanesT<T, Width>;
+        constexpr size_t kLanes = Width / sizeof(T);
+        const V broadcast = V{} + value;
+        size_t i = 0;
+        for (; i + kLanes <= n; i += kLanes) {
+            if (Any(Load<V>(data + i) == broadcast)) {
+                break;
+            }
+        }
+        for (; i < n; ++i) {
+            if (data[i] == value) {
+                return i;
+            }
+        }
+        return n;
+    }
+};
+
+struct CountKernel {
+    template <size_t Width, typename T>
+    static VECTOR_SIMD_INLINE size_t Run(const T* data, size_t n, T value) noexcept {
+        using V = LanesT<T, Width>;
+        using Mask = decltype(V{} == V{});
+        using Counter = std::remove_reference_t<decltype(Mask{}[0])>;
+        constexpr size_t kLanes = Width / sizeof(T);
+        // Установленная дорожка маски равна -1, поэтому счётчики дорожек сбрасываются до переполнения
+        constexpr size_t kFlushBlocks = std::min<uint64_t>(std::numeric_limits<Counter>::max(), uint64_t{1} << 20);
+        const V broadcast = V{} + value;
+        size_t count = 0;
+        size_t i = 0;
+        while (i + kLanes <= n) {
+            Mask counters{};
+            for (size_t block = 0; block < kFlushBlocks && i + kLanes <= n; ++block, i += kLanes) {
+                counters -= Load<V>(data + i) == broadcast;
+            }
+            for (size_t lane = 0; lane < kLanes; ++lane) {
+                count += static_cast<size_t>(counters[lane]);
+            }
+        }
+        for (; i < n; ++i) {
+            count += data[i] == value;
+        }
+        return count;
+    }
+};
+
+struct SumKernel {
+    template <size_t Width, typename T>
+    static VECTOR_SIMD_INLINE SumType<T> Run(const T* data, size_t n) noexcept {
+        using S = SumType<T>;
+        constexpr size_t kLanes = Width / sizeof(T);
+        using V = LanesT<T, Width>;
+        using Accumulator = LanesT<S, kLanes * sizeof(S)>;
+        Accumulator acc{};
+        size_t i = 0;
+        for (; i + kLanes <= n; i += kLanes) {
+            if constexpr (std::is_same_v<S, T>) {
+                acc += Load<V>(data + i);
+            } else {
+                acc += __builtin_convertvector(Load<V>(data + i), Accumulator);
+            }
+        }
+        S sum = 0;
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            sum += acc[lane];
+        }
+        for (; i < n; ++i) {
+            sum += data[i];
+        }
+        return sum;
+    }
+};
+
+struct MinMaxKernel {
+    template <size_t Width, typename T>
+    static VECTOR_SIMD_INLINE std::pair<T, T> Run(const T* data, size_t n) noexcept {
+        using V = LanesT<T, Width>;
+        constexpr size_t kLanes = Width / sizeof(T);
+        V min = V{} + data[0];
+        V max = min;
+        size_t i = 0;
+        for (; i + kLanes <= n; i += kLanes) {
+            const V chunk = Load<V>(data + i);
+            min = chunk < min ? chunk : min;
+            max = max < chunk ? chunk : max;
+        }
+        std::pair<T, T> result(min[0], max[0]);
+        for (size_t lane = 1; lane < kLanes; ++lane) {
+            result.first = min[lane] < result.first ? min[lane] : result.first;
+            result.second = result.second < max[lane] ? max[lane] : result.second;
+        }
+        for (; i < n; ++i) {
+            result.first = data[i] < result.first ? data[i] : result.first;
+            result.second = result.second < data[i] ? data[i] : result.second;
+        }
+        return result;
+    }
+};
+
+// Пользовательская операция скалярна, поэтому она применяется к блокам фиксированной длины:
+// такой цикл компилятор векторизует под набор инструкций варианта ядра
+struct TransformKernel {
+    template <size_t Width, typename T, typename Operation>
+    static VECTOR_SIMD_INLINE int Run(T* data, size_t n, Operation op) {
+        constexpr size_t kLanes = Width / sizeof(T);
+        size_t i = 0;
+        for (; i + kLanes <= n; i += kLanes) {
+            T block[kLanes];
+            std::memcpy(block, data + i, sizeof(block));
+            for (size_t lane = 0; lane < kLanes; ++lane) {
+                block[lane] = static_cast<T>(op(block[lane]));
+            }
+            std::memcpy(data + i, block, sizeof(block));
+        }
+        for (; i < n; ++i) {
+            data[i] = static_cast<T>(op(data[i]));
+        }
+        return 0;
+    }
+};
+
+struct EqualKernel {
+    template <size_t Width, typename T>
+    static VECTOR_SIMD_INLINE bool Run(const T* lhs, const T* rhs, size_t n) noexcept {
+        using V = LanesT<T, Width>;
+        constexpr size_t kLanes = Width / sizeof(T);
+        size_t i = 0;
+        for (; i + kLanes <= n; i += kLanes) {
+            if (!All(Load<V>(lhs + i) == Load<V>(rhs + i))) {
+                return false;
+            }
+        }
+        for (; i < n; ++i) {
+            if (!(lhs[i] == rhs[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+#if defined(__x86_64__) || defined(__i386__)
+
+enum class Isa {
+    Baseline,
+    Avx2,
+    Avx512,
+};
+
+inline Isa DetectIsa() noexcept {
+    static const Isa isa = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+            return Isa::Avx512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return Isa::Avx2;
+        }
+        return Isa::Baseline;
+    }();
+    return isa;
+}
+
+template <typename Kernel, typename... Args>
+__attribute__((target("avx512f,avx512bw"))) auto RunAvx512(Args... args) {
+    return Kernel::template Run<64>(args...);
+}
+
+template <typename Kernel, typename... Args>
+__attribute__((target("avx2"))) auto RunAvx2(Args... args) {
+    return Kernel::template Run<32>(args...);
+}
+
+#endif
+
+// Выполняет ядро с самыми широкими векторами, которые поддерживает процессор
+template <typename Kernel, typename... Args>
+auto Dispatch(Args... args) {
+#if defined(__x86_64__) || defined(__i386__)
+    switch (DetectIsa()) {
+        case Isa::Avx512:
+            return RunAvx512<Kernel>(args...);
+        case Isa::Avx2:
+            return RunAvx2<Kernel>(args...);
+        case Isa::Baseline:
+            break;
+    }
+#endif
+    return Kernel::template Run<16>(args...);
+}
+
+#undef VECTOR_SIMD_INLINE
+
+#pragma GCC diagnostic pop
+
+#endif  // defined(__GNUC__)
+
+}  // namespace detail::simd
+
+template <typename T>
+void Fill(Span<T> data, detail::TypeIdentityT<T> value) noexcept {
+    static_assert(detail::is_simd_arithmetic_v<T>, "Fill requires an arithmetic element type");
+#if defined(__GNUC__)
+    detail::simd::Dispatch<detail::simd::FillKernel>(data.Data(), data.Size(), static_cast<T>(value));
+#else
+    std::fill(data.begin(), data.end(), value);
+#endif
+}
+
+// Возвращает индекс первого элемента, равного value, или data.Size(), если такого нет
+template <typename T>
+size_t Find(Span<T> data, detail::TypeIdentityT<std::remove_const_t<T>> value) noexcept {
+    static_assert(detail::is_simd_arithmetic_v<T>, "Find requires an arithmetic element type");
+#if defined(__GNUC__)
+    return detail::simd::Dispatch<detail::simd::FindKernel>(static_cast<const T*>(data.Data()), data.Size(), value);
+#else
+    return std::find(data.begin(), data.end(), value) - data.begin();
+#endif
+}
+
+template <typename T>
+size_t Count(Span<T> data, detail::TypeIdentityT<std::remove_const_t<T>> value) noexcept {
+    static_assert(detail::is_simd_arithmetic_v<T>, "Count requires an arithmetic element type");
+#if defined(__GNUC__)
+    return detail::simd::Dispatch<detail::simd::CountKernel>(static_cast<const T*>(data.Data()), data.Size(), value);
+#else
+    return std::count(data.begin(), data.end(), value);
+#endif
+}
+
+// Сумма элементов. Порядок сложения не задан, поэтому сумма чисел с плавающей точкой
+// может отличаться от последовательной в пределах погрешности округления
+template <typename T>
+detail::SumType<std::remove_const_t<T>> Sum(Span<T> data) noexcept {
+    static_assert(detail::is_simd_arithmetic_v<T>, "Sum requires an arithmetic element type");
+#if defined(__GNUC__)
+    return detail::simd::Dispatch<detail::simd::SumKernel>(data.Data(), data.Size());
+#else
+    detail::SumType<std::remove_const_t<T>> sum = 0;
+    for (auto value : data) {
+        sum += value;
+    }
+    return sum;
+#endif
+}
+
+// Наименьший и наибольший элементы непустого массива. Значения NaN, кроме первого элемента, пропускаются
+template <typename T>
+std::pair<std::remove_const_t<T>, std::remove_const_t<T>> MinMax(Span<T> data) noexcept {
+    static_assert(detail::is_simd_arithmetic_v<T>, "MinMax requires an arithmetic element type");
+    assert(!data.Empty());
+#if defined(__GNUC__)
+    return detail::simd::Dispatch<detail::simd::MinMaxKernel>(data.Data(), data.Size());
+#else
+    std::pair<std::remove_const_t<T>, std::remove_const_t<T>> result(data[0], data[0]);
+    for (auto value : data) {
+        result.first = value < result.first ? value : result.first;
+        result.second = result.second < value ? value : result.second;
+    }
+    return result;
+#endif
+}
+
+// Заменяет каждый элемент x на op(x). Векторизуется, если op встраивается и состоит
+// из операций, доступных в векторных инструкциях, например [](auto x) { return x * 3 + 1; }
+template <typename T, typename Operation>
+void TransformInPlace(Span<T> data, Operation op) {
+    static_assert(detail::is_simd_arithmetic_v<T>, "TransformInPlace requires an arithmetic element type");
+#if defined(__GNUC__)
+    detail::simd::Dispatch<detail::simd::TransformKernel>(data.Data(), data.Size(), op);
+#else
+    for (T& value : data) {
+        value = static_cast<T>(op(value));
+    }
+#endif
+}
+
+// Поэлементное сравнение с обычной семантикой ==: NaN не равен ничему, а 0.0 равен -0.0
+template <typename T, typename U>
+bool Equal(Span<T> lhs, Span<U> rhs) noexcept {
+    static_assert(std::is_same_v<std::remove_const_t<T>, std::remove_const_t<U>>, "Equal requires equal element types");
+    static_assert(detail::is_simd_arithmetic_v<T>, "Equal requires an arithmetic element type");
+    if (lhs.Size() != rhs.Size()) {
+        return false;
+    }
+#if defined(__GNUC__)
+    return detail::simd::Dispatch<detail::simd::EqualKernel>(lhs.Data(), rhs.Data(), lhs.Size());
+#else
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+#endif
+}
+
+template <typename T, typename... Params>
+void Fill(Vector<T, Params...>& v, detail::TypeIdentityT<T> value) noexcept {
+    Fill(v.AsSpan(), value);
+}
+
+template <typename T, typename... Params>
+size_t Find(const Vector<T, Params...>& v, detail::TypeIdentityT<T> value) noexcept {
+    return Find(v.AsSpan(), value);
+}
+
+template <typename T, typename... Params>
+size_t Count(const Vector<T, Params...>& v, detail::TypeIdentityT<T> value) noexcept {
+    return Count(v.AsSpan(), value);
+}
+
+template <typename T, typename... Params>
+detail::SumType<T> Sum(const Vector<T, Params...>& v) noexcept {
+    return Sum(v.AsSpan());
+}
+
+template <typename T, typename... Params>
+std::pair<T, T> MinMax(const Vector<T, Params...>& v) noexcept {
+    return MinMax(v.AsSpan());
+}
+
+template <typename T, typename... Params, typename Operation>
+void TransformInPlace(Vector<T, Params...>& v, Operation op) {
+    TransformInPlace(v.AsSpan(), op);
+}
+
+template <typename T, typename... Params>
+bool Equal(const Vector<T, Params...>& lhs, const Vector<T, Params...>& rhs) noexcept {
+    return Equal(lhs.AsSpan(), rhs.AsSpan());
+}
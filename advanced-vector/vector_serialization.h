@@ -0,0 +1,185 @@
+#pragma once
+#include "vector.h"
+
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+// Сериализатор элементов типа T. Тривиально копируемые типы записываются побайтово, для остальных
+// типов шаблон специализируется статическими функциями Write(std::ostream&, const T&) и Read(std::istream&),
+// возвращающей прочитанный элемент. Специализации для std::string и вложенных Vector уже есть
+template <typename T, typename = void>
+struct Serializer {
+    static_assert(std::is_trivially_copyable_v<T>, "Serializer must be specialized for non-trivially copyable types");
+
+    static void Write(std::ostream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    static T Read(std::istream& in) {
+        T value;
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+            throw std::runtime_error("Deserialize: unexpected end of stream");
+        }
+        return value;
+    }
+};
+
+namespace detail {
+
+struct SerializedVectorHeader {
+    static constexpr uint32_t kMagic = 0x31534156;  // "VAS1" в little-endian
+
+    uint32_t magic;
+    // sizeof(T) для элементов, записанных побайтово одним блоком, и 0 для записанных сериализатором
+    uint32_t element_size;
+    uint64_t size;
+};
+
+// Размер блока, которым читаются тривиально копируемые элементы
+inline constexpr size_t kDeserializeChunkBytes = size_t{1} << 20;
+
+// Наибольший объём памяти, резервируемый заранее, если длину потока узнать нельзя
+inline constexpr size_t kDeserializeUncheckedReserveBytes = size_t{1} << 26;
+
+// Число байт от текущей позиции до конца потока или SIZE_MAX, если поток не поддерживает
+// позиционирование. Позиция потока не меняется
+inline size_t RemainingBytes(std::istream& in) {
+    const std::istream::pos_type pos = in.tellg();
+    if (pos == std::istream::pos_type(-1)) {
+        return std::numeric_limits<size_t>::max();
+    }
+    in.seekg(0, std::ios::end);
+    const std::istream::pos_type end = in.tellg();
+    in.clear();
+    in.seekg(pos);
+    if (end == std::istream::pos_type(-1) || end < pos) {
+        return std::numeric_limits<size_t>::max();
+    }
+    return static_cast<size_t>(end - pos);
+}
+
+template <typename T>
+inline constexpr uint32_t kSerializedElementSize = std::is_trivially_copyable_v<T> ? sizeof(T) : 0;
+
+}  // namespace detail
+
+// Записывает вектор в out: заголовок с размером, затем элементы. Буфер тривиально копируемых
+// элементов записывается напрямую, без промежуточных копий
+template <typename T, typename... Params>
+void Serialize(std::ostream& out, const Vector<T, Params...>& v) {
+    const detail::SerializedVectorHeader header{detail::SerializedVectorHeader::kMagic,
+                                                detail::kSerializedElementSize<T>, v.Size()};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        out.write(reinterpret_cast<const char*>(v.Data()), static_cast<std::streamsize>(v.Size() * sizeof(T)));
+    } else {
+        for (const T& value : v) {
+            Serializer<T>::Write(out, value);
+        }
+    }
+    if (!out) {
+        throw std::runtime_error("Serialize: failed to write to stream");
+    }
+}
+
+// Читает вектор, записанный Serialize, и заменяет им содержимое v. Вместимость резервируется один
+// раз по размеру из заголовка, а тривиально копируемые элементы читаются прямо в буфер блоками
+// по kDeserializeChunkBytes. Размер из заголовка сверяется с длиной потока, поэтому повреждённый
+// заголовок не приводит к огромному выделению памяти. Если длину потока узнать нельзя, заранее
+// резервируется не больше kDeserializeUncheckedReserveBytes, а дальше вектор растёт по мере чтения.
+// При ошибке выбрасывает std::runtime_error, оставляя v без изменений
+template <typename T, typename... Params>
+void Deserialize(std::istream& in, Vector<T, Params...>& v) {
+    detail::SerializedVectorHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::runtime_error("Deserialize: unexpected end of stream");
+    }
+    if (header.magic != detail::SerializedVectorHeader::kMagic) {
+        throw std::runtime_error("Deserialize: stream does not contain a serialized vector");
+    }
+    if (header.element_size != detail::kSerializedElementSize<T>) {
+        throw std::runtime_error("Deserialize: stream was written with a different element layout");
+    }
+    if (header.size > std::numeric_limits<size_t>::max() / sizeof(T)) {
+        throw std::runtime_error("Deserialize: vector size is out of range");
+    }
+
+    const size_t size = static_cast<size_t>(header.size);
+    const size_t remaining = detail::RemainingBytes(in);
+    const bool seekable = remaining != std::numeric_limits<size_t>::max();
+    constexpr size_t unchecked_limit = std::max<size_t>(1, detail::kDeserializeUncheckedReserveBytes / sizeof(T));
+    Vector<T, Params...> result(v.GetAllocator());
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        if (seekable && size > remaining / sizeof(T)) {
+            throw std::runtime_error("Deserialize: unexpected end of stream");
+        }
+        result.Reserve(seekable ? size : std::min(size, unchecked_limit));
+        constexpr size_t chunk = std::max<size_t>(1, detail::kDeserializeChunkBytes / sizeof(T));
+        while (result.Size() < size) {
+            const size_t offset = result.Size();
+            const size_t count = std::min(chunk, size - offset);
+            // Вместимость заканчивается только при чтении из потока без позиционирования
+            if (offset + count > result.Capacity()) {
+                result.Reserve(std::max(offset + count, std::min(size, result.Capacity() * 2)));
+            }
+            result.ResizeDefaultInit(offset + count);
+            if (!in.read(reinterpret_cast<char*>(result.Data() + offset), static_cast<std::streamsize>(count * sizeof(T)))) {
+                throw std::runtime_error("Deserialize: unexpected end of stream");
+            }
+        }
+    } else {
+        // Длина записи элемента заранее неизвестна. Резервирование по длине потока исходит из одного
+        // байта на элемент; если записи короче, вектор дорастёт при добавлении элементов
+        result.Reserve(std::min(size, seekable ? remaining : unchecked_limit));
+        for (size_t i = 0; i < size; ++i) {
+            result.EmplaceBack(Serializer<T>::Read(in));
+        }
+    }
+    v.Swap(result);
+}
+
+template <typename Char, typename Traits, typename StringAlloc>
+struct Serializer<std::basic_string<Char, Traits, StringAlloc>> {
+    using String = std::basic_string<Char, Traits, StringAlloc>;
+
+    static void Write(std::ostream& out, const String& value) {
+        const uint64_t size = value.size();
+        out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        out.write(reinterpret_cast<const char*>(value.data()), static_cast<std::streamsize>(value.size() * sizeof(Char)));
+    }
+
+    static String Read(std::istream& in) {
+        uint64_t size = 0;
+        if (!in.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+            throw std::runtime_error("Deserialize: unexpected end of stream");
+        }
+        String value;
+        // Строка растёт блоками, поэтому повреждённая длина не приводит к огромному выделению памяти
+        while (value.size() < size) {
+            const size_t offset = value.size();
+            const size_t count = std::min<uint64_t>(detail::kDeserializeChunkBytes / sizeof(Char), size - offset);
+            value.resize(offset + count);
+            if (!in.read(reinterpret_cast<char*>(value.data() + offset), static_cast<std::streamsize>(count * sizeof(Char)))) {
+                throw std::runtime_error("Deserialize: unexpected end of stream");
+            }
+        }
+        return value;
+    }
+};
+
+template <typename U, typename... Params>
+struct Serializer<Vector<U, Params...>> {
+    static void Write(std::ostream& out, const Vector<U, Params...>& value) {
+        Serialize(out, value);
+    }
+
+    static Vector<U, Params...> Read(std::istream& in) {
+        Vector<U, Params...> value;
+        Deserialize(in, value);
+        return value;
+    }
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+#include <cstddef>
+
+// Политика статистики, накапливающая счётчики событий памяти всех векторов, параметризованных ею.
+// Разные Tag дают независимые наборы счётчиков. Счётчики атомарны и обновляются с memory_order_relaxed,
+// поэтому политику можно использовать в многопоточных программах
+template <typename Tag = void>
+class VectorStats {
+public:
+    static void OnAllocate(size_t bytes) noexcept {
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    static void OnReallocate(ReallocationReason reason) noexcept {
+        reallocations_[static_cast<size_t>(reason)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void OnRelocate(RelocationKind kind, size_t count) noexcept {
+        relocated_[static_cast<size_t>(kind)].fetch_add(count, std::memory_order_relaxed);
+    }
+
+    static void OnCapacity(size_t capacity) noexcept {
+        size_t peak = peak_capacity_.load(std::memory_order_relaxed);
+        while (peak < capacity && !peak_capacity_.compare_exchange_weak(peak, capacity, std::memory_order_relaxed)) {
+        }
+    }
+
+    static size_t Allocations() noexcept {
+        return allocations_.load(std::memory_order_relaxed);
+    }
+
+    static size_t BytesAllocated() noexcept {
+        return bytes_allocated_.load(std::memory_order_relaxed);
+    }
+
+    static size_t Reallocations(ReallocationReason reason) noexcept {
+        return reallocations_[static_cast<size_t>(reason)].load(std::memory_order_relaxed);
+    }
+
+    // Количество элементов, перенесённых в новые буферы указанным способом
+    static size_t Relocated(RelocationKind kind) noexcept {
+        return relocated_[static_cast<size_t>(kind)].load(std::memory_order_relaxed);
+    }
+
+    static size_t PeakCapacity() noexcept {
+        return peak_capacity_.load(std::memory_order_relaxed);
+    }
+
+    static void Reset() noexcept {
+        allocations_.store(0, std::memory_order_relaxed);
+        bytes_allocated_.store(0, std::memory_order_relaxed);
+        for (auto& counter : reallocations_) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        for (auto& counter : relocated_) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        peak_capacity_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t kReasonCount = static_cast<size_t>(ReallocationReason::Shrink) + 1;
+    static constexpr size_t kKindCount = static_cast<size_t>(RelocationKind::Copy) + 1;
+
+    inline static std::atomic<size_t> allocations_{0};
+    inline static std::atomic<size_t> bytes_allocated_{0};
+    inline static std::atomic<size_t> reallocations_[kReasonCount] = {};
+    inline static std::atomic<size_t> relocated_[kKindCount] = {};
+    inline static std::atomic<size_t> peak_capacity_{0};
+};